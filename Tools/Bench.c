@@ -0,0 +1,635 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Micro-benchmarks for the tilemap, collision, raycast, particle, save, dialogue and world rendering hot paths
+// Results are written as JSON (median / p99 nanoseconds per operation and operations per second,
+// rendering benchmarks also get the draw call / batch counts of their last frame)
+// Given map JSONs (see Map_Generator) it only runs the tilemap scaling benchmarks on each of them instead, their
+// CreateTilemap results also get the memory the loaded tilemap takes up
+// Usage: Bench [output.json] [map.json ...] (DEFAULT: bin/bench.json)
+
+#include "Headless/Headless.h"
+#include "../src/World.h"
+#include "../src/Yellowwood.h"
+#include "../src/Particle.h"
+#include "../src/Save.h"
+#include "../src/Dialogue.h"
+#include "../src/Game_State.h"
+#include "../src/Render_Stats.h"
+#include "../src/input.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAP_PATH "Assets/Overworld/maps/Overworld/map.json"
+#define PROJECT_PATH "FNaF_World_Overworld_Map.json"
+#define BINARY_MAP_PATH "bin/bench_map.ywmap"
+#define SCALING_BINARY_MAP_PATH "bin/bench_scaling_map.ywmap"
+#define SAVE_PATH "bin/bench_save/save.json"
+#define DIALOGUE_PATH "example_dialogue.json"
+
+#define MAX_BENCHMARKS 32
+#define MAX_SAMPLES 1024
+
+typedef struct BenchResult
+{
+    char name[64];
+    uint32_t samples;
+    uint32_t ops_per_sample;
+    double median_ns; // Per operation
+    double p99_ns; // Per operation
+    double ops_per_sec;
+    _Bool has_render_stats;
+    RenderStats render_stats; // Of the last frame rendered
+    _Bool has_memory;
+    size_t tile_bytes; // GetTilemapTileBytes
+    size_t resident_bytes; // Resident memory the load added
+    size_t peak_resident_bytes; // Highest resident memory during the load (over what was resident before it)
+} BenchResult;
+
+static BenchResult Results[MAX_BENCHMARKS] = {0};
+static uint8_t AmountOfResults = 0;
+
+// Stops the compiler from optimizing benchmarked lookups away
+static volatile uint64_t Sink = 0;
+
+static uint32_t random_state = 0x9E3779B9;
+
+static uint32_t BenchRandom(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static int CompareDoubles(const void * a, const void * b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+// Times (samples) calls of function, each doing (ops_per_sample) operations, and stores the result
+static void RunBenchmark(const char * name, void (*function)(uint32_t), uint32_t samples, uint32_t ops_per_sample)
+{
+    static double sample_times[MAX_SAMPLES];
+
+    if (AmountOfResults == MAX_BENCHMARKS) return;
+    if (samples > MAX_SAMPLES) samples = MAX_SAMPLES;
+
+    function(ops_per_sample); // Warm up
+
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        uint64_t start = GetNanoseconds();
+        function(ops_per_sample);
+        uint64_t elapsed = GetNanoseconds() - start;
+        total += elapsed;
+        sample_times[i] = (double) elapsed / ops_per_sample;
+    }
+
+    qsort(sample_times, samples, sizeof(double), CompareDoubles);
+
+    BenchResult * result = Results + AmountOfResults++;
+    snprintf(result -> name, sizeof(result -> name), "%s", name);
+    result -> samples = samples;
+    result -> ops_per_sample = ops_per_sample;
+    result -> median_ns = sample_times[samples / 2];
+    result -> p99_ns = sample_times[(uint32_t) ((samples - 1) * 0.99)];
+    result -> ops_per_sec = (double) samples * ops_per_sample / (total / 1e9);
+
+    fprintf(stderr, "%-32s median %12.1f ns  p99 %12.1f ns  %14.0f ops/s\n", name, result -> median_ns, result -> p99_ns, result -> ops_per_sec);
+}
+
+// Attaches the last frame's render stats to the last benchmark result
+static void AttachRenderStats(void)
+{
+    if (!AmountOfResults) return;
+    Results[AmountOfResults - 1].has_render_stats = 1;
+    Results[AmountOfResults - 1].render_stats = GetLastFrameRenderStats();
+
+    RenderStats stats = GetLastFrameRenderStats();
+    fprintf(stderr, "%-32s %u quads, %u draw calls, %u flushes, %u texture binds, %u blend switches, %u target switches\n", "",
+            stats.quads, stats.draw_calls, stats.batch_flushes, stats.texture_binds, stats.blend_switches, stats.target_switches);
+}
+
+// Gets the resident memory of the process (or its peak with (peak)) from /proc, 0 if it can't be read
+static size_t GetResidentBytes(_Bool peak)
+{
+    FILE * file = fopen("/proc/self/status", "r");
+    if (!file) return 0;
+
+    char line[256];
+    size_t kilobytes = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        if (!strncmp(line, peak ? "VmHWM:" : "VmRSS:", 6))
+        {
+            kilobytes = strtoull(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return kilobytes * 1024;
+}
+
+// Resets the peak resident memory to the current resident memory
+static void ResetPeakResidentBytes(void)
+{
+    FILE * file = fopen("/proc/self/clear_refs", "w");
+    if (!file) return;
+    fputs("5", file);
+    fclose(file);
+}
+
+// Attaches memory figures to the last benchmark result
+static void AttachMemory(size_t tileBytes, size_t residentBytes, size_t peakResidentBytes)
+{
+    if (!AmountOfResults) return;
+    BenchResult * result = Results + AmountOfResults - 1;
+    result -> has_memory = 1;
+    result -> tile_bytes = tileBytes;
+    result -> resident_bytes = residentBytes;
+    result -> peak_resident_bytes = peakResidentBytes;
+
+    fprintf(stderr, "%-32s %.1f MB of tiles, %.1f MB resident, %.1f MB peak\n", "",
+            tileBytes / 1048576., residentBytes / 1048576., peakResidentBytes / 1048576.);
+}
+
+static void WriteResults(const char * path)
+{
+    FILE * file = fopen(path, "w");
+    if (!file)
+    {
+        fprintf(stderr, "Couldn't open \"%s\"!\n", path);
+        return;
+    }
+
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (uint8_t i = 0; i < AmountOfResults; i++)
+    {
+        fprintf(file, "    {\"name\": \"%s\", \"samples\": %u, \"ops_per_sample\": %u, \"median_ns\": %.1f, \"p99_ns\": %.1f, \"ops_per_sec\": %.1f",
+                Results[i].name, Results[i].samples, Results[i].ops_per_sample,
+                Results[i].median_ns, Results[i].p99_ns, Results[i].ops_per_sec);
+
+        if (Results[i].has_render_stats)
+        {
+            RenderStats * stats = &Results[i].render_stats;
+            fprintf(file, ", \"render_stats\": {\"quads\": %u, \"draw_calls\": %u, \"batch_flushes\": %u, \"texture_binds\": %u, \"blend_switches\": %u, \"target_switches\": %u}",
+                    stats -> quads, stats -> draw_calls, stats -> batch_flushes, stats -> texture_binds, stats -> blend_switches, stats -> target_switches);
+        }
+
+        if (Results[i].has_memory)
+        {
+            fprintf(file, ", \"memory\": {\"tile_bytes\": %zu, \"resident_bytes\": %zu, \"peak_resident_bytes\": %zu}",
+                    Results[i].tile_bytes, Results[i].resident_bytes, Results[i].peak_resident_bytes);
+        }
+
+        fprintf(file, "}%s\n", i + 1 < AmountOfResults ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+}
+
+// Tilemap
+
+static WORLDTilemap * BenchTilemap = NULL;
+
+static void Bench_CreateTilemap(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) FreeTilemap(CreateTilemapFromJSON(MAP_PATH));
+}
+
+// Headless images only have their size, so this times the base64 and layer decoding
+static void * DecodeBenchSpriteSheet(const unsigned char * data, size_t size)
+{
+    Image * image = malloc(sizeof(Image));
+    if (image) *image = LoadImageFromMemory(".png", data, size);
+    return image;
+}
+
+static void FreeBenchSpriteSheet(void * image)
+{
+    UnloadImage(*(Image *) image);
+    free(image);
+}
+
+static void Bench_CreateTilemapFromProject(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        WORLDSpriteSheets sheets;
+        FreeTilemap(CreateTilemapFromProject(PROJECT_PATH, DecodeBenchSpriteSheet, FreeBenchSpriteSheet, &sheets));
+        FreeSpriteSheets(&sheets, FreeBenchSpriteSheet);
+    }
+}
+
+static void Bench_LoadTilemapBinary(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) FreeTilemap(LoadTilemapBinary(BINARY_MAP_PATH));
+}
+
+static void Bench_AccessPositionInLayer(uint32_t ops)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        uint32_t random = BenchRandom();
+        WORLDTilemapLayer * layer = BenchTilemap -> layers + random % BenchTilemap -> amount;
+        sum += AccessPositionInLayer((random >> 8) % BenchTilemap -> mapWidth, (random >> 20) % BenchTilemap -> mapHeight, layer);
+    }
+    Sink += sum;
+}
+
+// Checks a hitbox against every layer (the same work UpdateWorldEntity does per axis)
+static void Bench_CheckCollisionTilemap(uint32_t ops)
+{
+    WORLDEntity entity = {0};
+    entity.size = (Vector2) {0.7, 0.45};
+    entity.collisionTargets = LAYER_COLLIDABLE;
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        uint32_t random = BenchRandom();
+        entity.position = (Vector2) {(random & 0xffff) % (BenchTilemap -> mapWidth * 100) / 100.f,
+                                     (random >> 16) % (BenchTilemap -> mapHeight * 100) / 100.f};
+        for (uint16_t layer = 1; layer < BenchTilemap -> amount; layer++)
+        {
+            sum += CheckCollisionTilemap(&entity, BenchTilemap -> layers + layer);
+        }
+    }
+    Sink += sum;
+}
+
+// Same hitbox check through the collision bit-grid
+static void Bench_CheckCollisionWorld(uint32_t ops)
+{
+    WORLDEntity entity = {0};
+    entity.size = (Vector2) {0.7, 0.45};
+    entity.collisionTargets = LAYER_COLLIDABLE;
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        uint32_t random = BenchRandom();
+        entity.position = (Vector2) {(random & 0xffff) % (BenchTilemap -> mapWidth * 100) / 100.f,
+                                     (random >> 16) % (BenchTilemap -> mapHeight * 100) / 100.f};
+        sum += IsSolidInRect(BenchTilemap, floorf(entity.position.x), floorf(entity.position.y),
+                             floorf(entity.position.x + entity.size.x), floorf(entity.position.y + entity.size.y));
+    }
+    Sink += sum;
+}
+
+// NPC vision like rays: groups of RAYS_PER_ORIGIN share an origin and fan out in every direction, up to 12 tiles long
+// They're cast in batches of BENCH_RAYS, an operation is one ray
+
+#define BENCH_RAYS 256
+#define RAYS_PER_ORIGIN 16
+
+static WORLDRay BenchRays[BENCH_RAYS];
+static WORLDRayHit BenchRayHits[BENCH_RAYS];
+
+static void FillBenchRays(const WORLDTilemap * tilemap)
+{
+    for (uint32_t i = 0; i < BENCH_RAYS; i += RAYS_PER_ORIGIN)
+    {
+        float x = BenchRandom() % (tilemap -> mapWidth * 100) / 100.f, y = BenchRandom() % (tilemap -> mapHeight * 100) / 100.f;
+        for (uint32_t ray = 0; ray < RAYS_PER_ORIGIN; ray++)
+        {
+            float angle = ray * 6.2831853f / RAYS_PER_ORIGIN;
+            BenchRays[i + ray] = (WORLDRay) {x, y, cosf(angle), sinf(angle), 12};
+        }
+    }
+}
+
+static void Bench_CastTileRays(uint32_t ops)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i += BENCH_RAYS) sum += CastTileRays(BenchTilemap, BenchRays, BenchRayHits, BENCH_RAYS);
+    Sink += sum;
+}
+
+// Tilemap scaling
+
+static const char * ScalingMapPath = NULL;
+static WORLDTilemap * ScalingTilemap = NULL;
+
+static void Bench_CreateTilemapScaling(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) FreeTilemap(CreateTilemapFromJSON(ScalingMapPath));
+}
+
+static void Bench_LoadTilemapBinaryScaling(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) FreeTilemap(LoadTilemapBinary(SCALING_BINARY_MAP_PATH));
+}
+
+// Renders every layer of the overworld tilemap from a random camera position (the same tiles RenderWorld goes through)
+// The view is kept on the map like the camera is in game
+static void Bench_RenderLayers(uint32_t ops)
+{
+    float marginX = fminf(WorldCamera.zoom * 2, ScalingTilemap -> mapWidth / 2.f);
+    float marginY = fminf(WorldCamera.zoom, ScalingTilemap -> mapHeight / 2.f);
+
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        WorldCamera.position = (Vector2) {marginX + BenchRandom() % 10000 / 10000.f * (ScalingTilemap -> mapWidth - marginX * 2),
+                                          marginY + BenchRandom() % 10000 / 10000.f * (ScalingTilemap -> mapHeight - marginY * 2)};
+        for (uint16_t layer = ScalingTilemap -> amount; layer > 0; layer--) RenderLayer(layer - 1, (Vector2) {0, 0});
+        EndRenderStatsFrame();
+    }
+}
+
+static void Bench_AccessPositionInLayerScaling(uint32_t ops)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        uint32_t random = BenchRandom();
+        WORLDTilemapLayer * layer = ScalingTilemap -> layers + random % ScalingTilemap -> amount;
+        sum += AccessPositionInLayer(BenchRandom() % ScalingTilemap -> mapWidth, BenchRandom() % ScalingTilemap -> mapHeight, layer);
+    }
+    Sink += sum;
+}
+
+// Freddy sized hitboxes anywhere on the map through the collision bit-grid
+static void Bench_IsSolidInRectScaling(uint32_t ops)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        float x = BenchRandom() % (ScalingTilemap -> mapWidth * 100) / 100.f;
+        float y = BenchRandom() % (ScalingTilemap -> mapHeight * 100) / 100.f;
+        sum += IsSolidInRect(ScalingTilemap, floorf(x), floorf(y), floorf(x + 0.7f), floorf(y + 0.45f));
+    }
+    Sink += sum;
+}
+
+static void Bench_CastTileRaysScaling(uint32_t ops)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < ops; i += BENCH_RAYS) sum += CastTileRays(ScalingTilemap, BenchRays, BenchRayHits, BENCH_RAYS);
+    Sink += sum;
+}
+
+// Runs the tilemap scaling benchmarks on a map JSON, returns 0 if it couldn't be loaded
+static _Bool RunScalingBenchmarks(const char * path)
+{
+    ScalingMapPath = path;
+
+    // Memory is measured on a load of its own, before anything else is allocated for this map
+
+    ResetPeakResidentBytes();
+    size_t before = GetResidentBytes(0);
+    ScalingTilemap = CreateTilemapFromJSON(path);
+    size_t resident = GetResidentBytes(0), peak = GetResidentBytes(1);
+    if (!ScalingTilemap)
+    {
+        fprintf(stderr, "Couldn't load \"%s\"!\n", path);
+        return 0;
+    }
+
+    char name[64];
+    uint32_t tiles = (uint32_t) ScalingTilemap -> mapWidth * ScalingTilemap -> mapHeight;
+    uint32_t samples = tiles <= 256 * 256 ? 20 : tiles <= 1024 * 1024 ? 5 : 3;
+
+    snprintf(name, sizeof(name), "CreateTilemap_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+    RunBenchmark(name, Bench_CreateTilemapScaling, samples, 1);
+    AttachMemory(GetTilemapTileBytes(ScalingTilemap), resident > before ? resident - before : 0, peak > before ? peak - before : 0);
+
+    if (SaveTilemapBinary(ScalingTilemap, SCALING_BINARY_MAP_PATH))
+    {
+        snprintf(name, sizeof(name), "LoadTilemapBinary_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+        RunBenchmark(name, Bench_LoadTilemapBinaryScaling, 50, 1);
+    }
+
+    // Rendered as the overworld tilemap so RenderLayer sees it with the overworld tileset
+
+    WORLDTilemap * overworld = SwapWorldTilemap(ScalingTilemap);
+    snprintf(name, sizeof(name), "RenderLayers_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+    RunBenchmark(name, Bench_RenderLayers, 200, 1);
+    AttachRenderStats();
+
+    snprintf(name, sizeof(name), "AccessPositionInLayer_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+    RunBenchmark(name, Bench_AccessPositionInLayerScaling, 200, 65536);
+    snprintf(name, sizeof(name), "IsSolidInRect_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+    RunBenchmark(name, Bench_IsSolidInRectScaling, 200, 16384);
+    FillBenchRays(ScalingTilemap);
+    snprintf(name, sizeof(name), "CastTileRays_%ux%u", ScalingTilemap -> mapWidth, ScalingTilemap -> mapHeight);
+    RunBenchmark(name, Bench_CastTileRaysScaling, 200, 16384);
+
+    SwapWorldTilemap(overworld);
+    FreeTilemap(ScalingTilemap);
+    ScalingTilemap = NULL;
+    return 1;
+}
+
+// Particles
+
+static uint8_t BenchParticle = 0;
+
+// Fills the particle array with (amount) particles that never leave the screen, returns 0 if some of them weren't made
+// or didn't survive an update
+static _Bool FillParticles(uint16_t amount)
+{
+    FlushParticles();
+    for (uint16_t i = 0; i < amount; i++)
+    {
+        CreateParticle(BenchParticle, ((int) (BenchRandom() % 200) - 100) / 200.f, ((int) (BenchRandom() % 200) - 100) / 200.f, 0, 0);
+    }
+    UpdateUIParticles();
+
+    if (GetParticleCount() != amount)
+    {
+        fprintf(stderr, "Only %u of %u particles are left after filling!\n", GetParticleCount(), amount);
+        return 0;
+    }
+    return 1;
+}
+
+static void Bench_UpdateUIParticles(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) UpdateUIParticles();
+}
+
+// Save and Dialogue
+
+static void Bench_WriteSave(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) WriteSave((Vector2) {38, 21});
+}
+
+static void Bench_LoadSave(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) LoadSave(SAVE_PATH);
+}
+
+static void Bench_LoadDialogue(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) LoadDialogue(DIALOGUE_PATH);
+}
+
+// Rendering
+
+static void Bench_RenderWorld(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        RenderWorld();
+        EndRenderStatsFrame();
+    }
+}
+
+// Spreads the overworld tiles over two pages, the second one is the same spritesheet again and every other tile id is
+// moved onto it so both pages are used all over the map (the map itself is left alone)
+static _Bool SplitWorldTilesetPages(void)
+{
+    extern WORLDTileset * CurrentWorldTileset;
+
+    WORLDTile first = AddWorldSpriteSheet("Assets/Overworld/maps/Overworld/spritesheet.png");
+    if (!first) return 0;
+
+    for (WORLDTile id = 2; id < first; id += 2) CurrentWorldTileset -> tiles[id].page = 1;
+    return 1;
+}
+
+static void Bench_LoadWorldProject(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++) Sink += LoadWorldProject(PROJECT_PATH);
+}
+
+static void Bench_PutWorld(uint32_t ops)
+{
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        BeginInputFrame();
+        PutWorld();
+        EndRenderStatsFrame();
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    const char * output = argc > 1 ? argv[1] : "bin/bench.json";
+
+    // Tilemap scaling benchmarks only (the tileset comes from the overworld, which needs a save)
+
+    if (argc > 2)
+    {
+        LoadSave(SAVE_PATH);
+        SwapGameState(World);
+
+        _Bool success = 1;
+        for (int i = 2; i < argc; i++) success = RunScalingBenchmarks(argv[i]) && success;
+
+        WriteResults(output);
+        return success ? 0 : 1;
+    }
+
+    // Tilemap benchmarks
+
+    BenchTilemap = CreateTilemapFromJSON(MAP_PATH);
+    if (!BenchTilemap)
+    {
+        fprintf(stderr, "Couldn't load \"%s\"!\n", MAP_PATH);
+        return 1;
+    }
+
+    RunBenchmark("CreateTilemap", Bench_CreateTilemap, 50, 1);
+    RunBenchmark("CreateTilemapFromProject", Bench_CreateTilemapFromProject, 50, 1);
+    if (SaveTilemapBinary(BenchTilemap, BINARY_MAP_PATH)) RunBenchmark("LoadTilemapBinary", Bench_LoadTilemapBinary, 200, 16);
+    RunBenchmark("AccessPositionInLayer", Bench_AccessPositionInLayer, 200, 65536);
+    RunBenchmark("CheckCollisionTilemap_AllLayers", Bench_CheckCollisionTilemap, 200, 16384);
+    RunBenchmark("IsSolidInRect", Bench_CheckCollisionWorld, 200, 16384);
+    FillBenchRays(BenchTilemap);
+    RunBenchmark("CastTileRays", Bench_CastTileRays, 200, 16384);
+
+    // Particle benchmarks
+
+    BenchParticle = CreateParticleIndexA_V2("Assets/Particles/bird.png", 30, 10, (Vector2) {50, 50}, 1.5);
+
+    if (!FillParticles(1000)) return 1;
+    RunBenchmark("UpdateUIParticles_1k", Bench_UpdateUIParticles, 200, 1);
+    if (!FillParticles(8000)) return 1;
+    RunBenchmark("UpdateUIParticles_8k", Bench_UpdateUIParticles, 200, 1);
+    if (!FillParticles(MAX_PARTICLES)) return 1;
+    RunBenchmark("UpdateUIParticles_16k", Bench_UpdateUIParticles, 200, 1);
+    FlushParticles();
+
+    // Save and dialogue benchmarks
+
+    LoadSave(SAVE_PATH);
+    RunBenchmark("WriteSave", Bench_WriteSave, 200, 1);
+    RunBenchmark("LoadSave", Bench_LoadSave, 200, 1);
+    RunBenchmark("LoadDialogue", Bench_LoadDialogue, 200, 1);
+
+    // Rendering benchmarks (drawing is a no-op headless, so these time the CPU side and count what would reach rlgl)
+
+    SwapGameState(World);
+    RunBenchmark("RenderWorld", Bench_RenderWorld, 200, 1);
+    AttachRenderStats();
+    RunBenchmark("PutWorld", Bench_PutWorld, 200, 1);
+    AttachRenderStats();
+
+    // Two page tileset, with the page batch RenderLayer binds each page at most once per layer
+
+    if (!SplitWorldTilesetPages())
+    {
+        fprintf(stderr, "Couldn't add a second spritesheet page!\n");
+        return 1;
+    }
+    RunBenchmark("RenderWorld_2Pages", Bench_RenderWorld, 200, 1);
+    AttachRenderStats();
+    SetWorldPageBatching(0);
+    RunBenchmark("RenderWorld_2Pages_Unbatched", Bench_RenderWorld, 200, 1);
+    AttachRenderStats();
+    SetWorldPageBatching(1);
+
+    // Overworld from the Spritefusion project, re-entering the World state checks that InitWorld keeps its spritesheets
+
+    RunBenchmark("LoadWorldProject", Bench_LoadWorldProject, 20, 1);
+    if (!LoadWorldProject(PROJECT_PATH))
+    {
+        fprintf(stderr, "Couldn't load \"%s\"!\n", PROJECT_PATH);
+        return 1;
+    }
+    SwapGameState(World);
+    RunBenchmark("RenderWorld_Project", Bench_RenderWorld, 200, 1);
+    AttachRenderStats();
+
+    WriteResults(output);
+    FreeTilemap(BenchTilemap);
+    return 0;
+}
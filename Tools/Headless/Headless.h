@@ -0,0 +1,51 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Headless Raylib: a window-less, GPU-less and audio-less stand-in for the parts of Raylib the game uses
+// Textures only keep their size (read from the PNG header), drawing does nothing, and input + frame time
+// are driven by the calls below so simulation runs are deterministic
+
+#pragma once
+
+#include "../../Include/raylib.h"
+#include <stdint.h>
+
+// Sets the value GetFrameTime() returns (fixed dt)
+void SetHeadlessFrameTime(float seconds);
+
+// Sets the size GetScreenWidth() / GetScreenHeight() return (DEFAULT: 1280x720)
+void SetHeadlessScreenSize(int width, int height);
+
+// Holds down or releases a key
+void SetHeadlessKey(int key, _Bool down);
+
+// Releases every key
+void ClearHeadlessKeys(void);
+
+// Sets the mouse position and if the left mouse button is held down
+void SetHeadlessMouse(Vector2 position, _Bool down);
+
+// Advances the headless input state by one frame (needed for IsKeyPressed / IsMouseButtonPressed edges)
+void StepHeadlessFrame(void);
+
+// Gets the amount of frames stepped so far
+uint64_t GetHeadlessFrameCount(void);
@@ -0,0 +1,506 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define RAYMATH_IMPLEMENTATION
+
+#include "Headless.h"
+#include "Headless_Compat.h"
+#include "../../Include/raylib.h"
+#include "../../Include/raymath.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+#define HEADLESS_MAX_KEYS 512
+
+static float frame_time = 1 / 240.f;
+static int screen_width = 1280;
+static int screen_height = 720;
+
+static _Bool keys_down[HEADLESS_MAX_KEYS] = {0};
+static _Bool keys_last[HEADLESS_MAX_KEYS] = {0};
+
+static Vector2 mouse_position = {0};
+static _Bool mouse_down = 0;
+static _Bool mouse_last = 0;
+
+static uint64_t frame_count = 0;
+static uint32_t random_state = 0x2545F491;
+static unsigned int texture_ids = 1;
+static uintptr_t audio_buffers = 1;
+
+// Headless controls
+
+void SetHeadlessFrameTime(float seconds)
+{
+    frame_time = seconds;
+}
+
+void SetHeadlessScreenSize(int width, int height)
+{
+    screen_width = width;
+    screen_height = height;
+}
+
+void SetHeadlessKey(int key, _Bool down)
+{
+    if (key < 0 || key >= HEADLESS_MAX_KEYS) return;
+    keys_down[key] = down;
+}
+
+void ClearHeadlessKeys(void)
+{
+    memset(keys_down, 0, sizeof(keys_down));
+}
+
+void SetHeadlessMouse(Vector2 position, _Bool down)
+{
+    mouse_position = position;
+    mouse_down = down;
+}
+
+void StepHeadlessFrame(void)
+{
+    memcpy(keys_last, keys_down, sizeof(keys_down));
+    mouse_last = mouse_down;
+    frame_count++;
+}
+
+uint64_t GetHeadlessFrameCount(void)
+{
+    return frame_count;
+}
+
+// Missing CRT functions
+
+int strcpy_s(char * dest, size_t size, const char * src)
+{
+    size_t length = strlen(src);
+    if (!dest || length >= size) return 1;
+    memcpy(dest, src, length + 1);
+    return 0;
+}
+
+// Reads the width and height out of a PNG's IHDR chunk, returns 0 if the data isn't a PNG
+static _Bool ReadPNGHeader(const uint8_t * header, size_t size, int * width, int * height)
+{
+    if (size < 24 || memcmp(header + 1, "PNG", 3)) return 0;
+
+    *width = header[16] << 24 | header[17] << 16 | header[18] << 8 | header[19];
+    *height = header[20] << 24 | header[21] << 16 | header[22] << 8 | header[23];
+    return 1;
+}
+
+// Same as ReadPNGHeader but reads the header from a file
+static _Bool ReadPNGSize(const char * path, int * width, int * height)
+{
+    uint8_t header[24] = {0};
+    FILE * file = fopen(path, "rb");
+    if (!file) return 0;
+    size_t read = fread(header, 1, sizeof(header), file);
+    fclose(file);
+
+    return ReadPNGHeader(header, read, width, height);
+}
+
+// Window and drawing
+
+void InitWindow(int width, int height, const char * title) { screen_width = width, screen_height = height; }
+void CloseWindow(void) {}
+bool WindowShouldClose(void) { return 0; }
+void SetWindowState(unsigned int flags) {}
+void SetWindowMinSize(int width, int height) {}
+void SetWindowTitle(const char * title) {}
+void SetTargetFPS(int fps) {}
+void SetTraceLogLevel(int logLevel) {}
+void HideCursor(void) {}
+int GetScreenWidth(void) { return screen_width; }
+int GetScreenHeight(void) { return screen_height; }
+Vector2 GetWindowScaleDPI(void) { return (Vector2) {1, 1}; }
+float GetFrameTime(void) { return frame_time; }
+double GetTime(void) { return frame_count * (double) frame_time; }
+int GetFPS(void) { return frame_time > 0 ? (int) (1 / frame_time) : 0; }
+
+void BeginDrawing(void) {}
+void EndDrawing(void) {}
+void ClearBackground(Color color) {}
+void BeginTextureMode(RenderTexture2D target) {}
+void EndTextureMode(void) {}
+void BeginBlendMode(int mode) {}
+void EndBlendMode(void) {}
+
+void DrawFPS(int posX, int posY) {}
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {}
+void DrawRectangleRec(Rectangle rec, Color color) {}
+void DrawText(const char * text, int posX, int posY, int fontSize, Color color) {}
+void DrawTextPro(Font font, const char * text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint) {}
+void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) {}
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {}
+
+// Textures and fonts
+
+Texture2D LoadTexture(const char * fileName)
+{
+    Texture2D texture = {0};
+    if (!ReadPNGSize(fileName, &texture.width, &texture.height))
+    {
+        printf("HEADLESS: Failed to load texture \"%s\"\n", fileName);
+        return texture;
+    }
+    texture.id = texture_ids++;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return texture;
+}
+
+// Images only keep their size, there's nothing to draw them with anyway
+
+Image LoadImageFromMemory(const char * fileType, const unsigned char * fileData, int dataSize)
+{
+    Image image = {0};
+    if (!fileData || !ReadPNGHeader(fileData, dataSize, &image.width, &image.height))
+    {
+        printf("HEADLESS: Failed to load %s image from memory\n", fileType);
+        return image;
+    }
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+Image LoadImage(const char * fileName)
+{
+    Image image = {0};
+    if (!ReadPNGSize(fileName, &image.width, &image.height))
+    {
+        printf("HEADLESS: Failed to load image \"%s\"\n", fileName);
+        return image;
+    }
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+Image GenImageColor(int width, int height, Color color)
+{
+    return (Image) {NULL, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+}
+
+// There are no pixels to give back or draw
+Color * LoadImageColors(Image image) { return NULL; }
+void UnloadImageColors(Color * colors) {}
+void ImageDraw(Image * dst, Image src, Rectangle srcRec, Rectangle dstRec, Color tint) {}
+
+void UnloadImage(Image image) {}
+
+Texture2D LoadTextureFromImage(Image image)
+{
+    if (!image.width || !image.height) return (Texture2D) {0};
+    return (Texture2D) {texture_ids++, image.width, image.height, 1, image.format};
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D target = {0};
+    target.id = texture_ids++;
+    target.texture = (Texture2D) {texture_ids++, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    return target;
+}
+
+int GetPixelDataSize(int width, int height, int format)
+{
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return width * height;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: return width * height * 2;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return width * height * 3;
+        default: return width * height * 4;
+    }
+}
+
+bool IsTextureValid(Texture2D texture) { return texture.id != 0; }
+void UnloadTexture(Texture2D texture) {}
+void UnloadRenderTexture(RenderTexture2D target) {}
+void SetTextureFilter(Texture2D texture, int filter) {}
+void SetTextureWrap(Texture2D texture, int wrap) {}
+
+Font GetFontDefault(void)
+{
+    return (Font) {.baseSize = 10};
+}
+
+Font LoadFont(const char * fileName)
+{
+    return (Font) {.baseSize = 32, .texture = {texture_ids++, 512, 512, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8}};
+}
+
+Font LoadFontFromMemory(const char * fileType, const unsigned char * fileData, int dataSize, int fontSize, int * codepoints, int codepointCount)
+{
+    return (Font) {.baseSize = fontSize, .texture = {texture_ids++, 512, 512, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8}};
+}
+
+void UnloadFont(Font font) {}
+
+int MeasureText(const char * text, int fontSize)
+{
+    return (int) strlen(text) * fontSize / 2;
+}
+
+Vector2 MeasureTextEx(Font font, const char * text, float fontSize, float spacing)
+{
+    return (Vector2) {strlen(text) * (fontSize / 2 + spacing), fontSize};
+}
+
+// Audio
+
+void InitAudioDevice(void) {}
+void CloseAudioDevice(void) {}
+
+// Rough stand-in for a decoded stream in Raylib's device format (32 bit float stereo), one frame per 4 bytes of file
+static AudioStream LoadHeadlessAudio(const char * fileName, unsigned int * frameCount)
+{
+    struct stat info;
+    if (stat(fileName, &info) || !S_ISREG(info.st_mode))
+    {
+        *frameCount = 0;
+        return (AudioStream) {0};
+    }
+    *frameCount = info.st_size / 4 + 1;
+    return (AudioStream) {.buffer = (rAudioBuffer *) audio_buffers++, .sampleRate = 44100, .sampleSize = 32, .channels = 2};
+}
+
+Sound LoadSound(const char * fileName)
+{
+    Sound sound = {0};
+    sound.stream = LoadHeadlessAudio(fileName, &sound.frameCount);
+    return sound;
+}
+
+// One frame per 4 bytes of data, same as LoadHeadlessAudio
+Wave LoadWaveFromMemory(const char * fileType, const unsigned char * fileData, int dataSize)
+{
+    if (!fileData || dataSize <= 0) return (Wave) {0};
+    return (Wave) {.frameCount = dataSize / 4 + 1, .sampleRate = 44100, .sampleSize = 32, .channels = 2};
+}
+
+void UnloadWave(Wave wave) {}
+
+Sound LoadSoundFromWave(Wave wave)
+{
+    Sound sound = {0};
+    if (!wave.frameCount) return sound;
+    sound.stream = (AudioStream) {.buffer = (rAudioBuffer *) audio_buffers++, .sampleRate = 44100, .sampleSize = 32, .channels = 2};
+    sound.frameCount = wave.frameCount;
+    return sound;
+}
+
+bool IsSoundValid(Sound sound) { return sound.frameCount != 0; }
+void PlaySound(Sound sound) {}
+void UnloadSound(Sound sound) {}
+
+Music LoadMusicStream(const char * fileName)
+{
+    Music music = {0};
+    music.stream = LoadHeadlessAudio(fileName, &music.frameCount);
+    return music;
+}
+
+void PlayMusicStream(Music music) {}
+void StopMusicStream(Music music) {}
+void UpdateMusicStream(Music music) {}
+void SeekMusicStream(Music music, float position) {}
+void UnloadMusicStream(Music music) {}
+
+// Input
+
+bool IsKeyDown(int key)
+{
+    return key >= 0 && key < HEADLESS_MAX_KEYS && keys_down[key];
+}
+
+bool IsKeyPressed(int key)
+{
+    return IsKeyDown(key) && !keys_last[key];
+}
+
+int GetKeyPressed(void)
+{
+    for (int key = 0; key < HEADLESS_MAX_KEYS; key++)
+    {
+        if (IsKeyPressed(key)) return key;
+    }
+    return 0;
+}
+
+bool IsMouseButtonDown(int button) { return button == MOUSE_BUTTON_LEFT && mouse_down; }
+bool IsMouseButtonPressed(int button) { return button == MOUSE_BUTTON_LEFT && mouse_down && !mouse_last; }
+Vector2 GetMousePosition(void) { return mouse_position; }
+int GetTouchPointCount(void) { return 0; }
+Vector2 GetTouchPosition(int index) { return index == 0 && mouse_down ? mouse_position : (Vector2) {0, 0}; }
+
+// Misc
+
+void SetRandomSeed(unsigned int seed)
+{
+    // xorshift32 gets stuck on 0
+    random_state = seed ? seed : 0x2545F491;
+}
+
+int GetRandomValue(int min, int max)
+{
+    if (min > max)
+    {
+        int temp = max;
+        max = min;
+        min = temp;
+    }
+
+    // xorshift32 so headless runs are repeatable
+
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return min + (int) (random_state % ((unsigned int) (max - min) + 1));
+}
+
+bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    return  rec1.x < rec2.x + rec2.width && rec1.x + rec1.width > rec2.x &&
+            rec1.y < rec2.y + rec2.height && rec1.y + rec1.height > rec2.y;
+}
+
+bool CheckCollisionPointRec(Vector2 point, Rectangle rec)
+{
+    return  point.x >= rec.x && point.x < rec.x + rec.width &&
+            point.y >= rec.y && point.y < rec.y + rec.height;
+}
+
+// Files
+
+bool FileExists(const char * fileName)
+{
+    struct stat info;
+    return stat(fileName, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+bool DirectoryExists(const char * dirPath)
+{
+    struct stat info;
+    return stat(dirPath, &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+int MakeDirectory(const char * dirPath)
+{
+    return mkdir(dirPath, 0755);
+}
+
+const char * GetDirectoryPath(const char * filePath)
+{
+    static char directory[4096];
+    const char * slash = strrchr(filePath, '/');
+    if (!slash) return ".";
+    size_t length = slash - filePath;
+    if (length >= sizeof(directory)) length = sizeof(directory) - 1;
+    memcpy(directory, filePath, length);
+    directory[length] = '\0';
+    return directory;
+}
+
+unsigned char * LoadFileData(const char * fileName, int * dataSize)
+{
+    *dataSize = 0;
+    FILE * file = fopen(fileName, "rb");
+    if (!file)
+    {
+        printf("HEADLESS: Failed to open file \"%s\"\n", fileName);
+        return NULL;
+    }
+
+    fseek(file, 0L, SEEK_END);
+    long length = ftell(file);
+    rewind(file);
+
+    unsigned char * data = length > 0 ? malloc(length) : NULL;
+    if (data) *dataSize = fread(data, 1, length, file);
+    fclose(file);
+    return data;
+}
+
+void UnloadFileData(unsigned char * data)
+{
+    free(data);
+}
+
+int GetFileLength(const char * fileName)
+{
+    struct stat info;
+    return stat(fileName, &info) ? 0 : (int) info.st_size;
+}
+
+const char * GetFileExtension(const char * fileName)
+{
+    const char * dot = strrchr(fileName, '.');
+    return dot && dot != fileName ? dot : NULL;
+}
+
+bool IsFileExtension(const char * fileName, const char * ext)
+{
+    const char * extension = GetFileExtension(fileName);
+    return extension && !strcasecmp(extension, ext);
+}
+
+char * LoadFileText(const char * fileName)
+{
+    FILE * file = fopen(fileName, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0L, SEEK_END);
+    long length = ftell(file);
+    rewind(file);
+
+    char * text = malloc(length + 1);
+    if (!text)
+    {
+        fclose(file);
+        return NULL;
+    }
+    text[fread(text, 1, length, file)] = '\0';
+    fclose(file);
+    return text;
+}
+
+void UnloadFileText(char * text)
+{
+    free(text);
+}
+
+bool SaveFileText(const char * fileName, char * text)
+{
+    FILE * file = fopen(fileName, "wb");
+    if (!file) return 0;
+    fputs(text, file);
+    fclose(file);
+    return 1;
+}
@@ -0,0 +1,66 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// Map compiler, converts a Spritefusion map JSON (map export or project file) to a compiled .ywmap that CreateTilemap
+// maps straight into memory instead of parsing the JSON
+// Usage: Map_Compiler <map.json> [output.ywmap] (DEFAULT: the JSON path with a .ywmap extension)
+
+#include "../src/Yellowwood.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <map.json> [output%s]\n", argv[0], YWMAP_EXTENSION);
+        return EXIT_FAILURE;
+    }
+
+    // "maps/map.json" -> "maps/map.ywmap"
+
+    char output[1024];
+    if (argc > 2) snprintf(output, sizeof(output), "%s", argv[2]);
+    else
+    {
+        const char * extension = strrchr(argv[1], '.');
+        int baseLength = extension && !strpbrk(extension, "/\\") ? (int) (extension - argv[1]) : (int) strlen(argv[1]);
+        snprintf(output, sizeof(output), "%.*s%s", baseLength, argv[1], YWMAP_EXTENSION);
+    }
+
+    WORLDTilemap * tilemap = CreateTilemapFromJSON(argv[1]);
+    if (!tilemap)
+    {
+        fprintf(stderr, "Couldn't load \"%s\"!\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    _Bool success = SaveTilemapBinary(tilemap, output);
+    if (success) printf("%s -> %s (%u layers, %ux%u, %.1f KB of tiles)\n", argv[1], output, tilemap -> amount, tilemap -> mapWidth,
+                        tilemap -> mapHeight, GetTilemapTileBytes(tilemap) / 1024.);
+
+    FreeTilemap(tilemap);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// Synthetic map generator, writes a Spritefusion map JSON of any size for the tilemap scaling benchmarks
+// The last layer is a full "Ground" layer, the ones above it get patches of tiles until (density) percent of the map is
+// covered (overlapping patches make it a bit less), layer 1 is collidable like the overworld's "Walls"
+// Usage: Map_Generator <output.json> <width> [height] [layers] [density] [seed]
+// (DEFAULT: height = width, 4 layers, 10% density, seed 1)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_MAP_SIZE 65535
+#define MAX_PATCH_SIZE 8 // Patches are 1x1 up to MAX_PATCH_SIZE x MAX_PATCH_SIZE tiles
+
+// Spritefusion tile ids from the overworld spritesheet, so the maps draw with it
+static const uint16_t GroundIds[] = {80, 81, 82, 83, 84, 85, 86, 87};
+static const uint16_t DecorationIds[] = {2, 3, 4, 31, 32, 33, 45, 46, 47, 77, 88};
+
+static uint32_t random_state = 1;
+
+static uint32_t GeneratorRandom(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+// Writes every set tile of a layer's bit-grid row by row
+static _Bool WriteLayer(FILE * file, const uint64_t * grid, uint32_t width, uint32_t height, const char * name, _Bool collider,
+                        const uint16_t * ids, uint32_t amountOfIds, _Bool last)
+{
+    uint32_t words = (width + 63) / 64;
+    _Bool first = 1;
+
+    fprintf(file, "{\"name\":\"%s\",\"tiles\":[", name);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            if (!(grid[(size_t) y * words + (x >> 6)] >> (x & 63) & 1)) continue;
+            fprintf(file, "%s{\"id\":\"%u\",\"x\":%u,\"y\":%u}", first ? "" : ",", ids[GeneratorRandom() % amountOfIds], x, y);
+            first = 0;
+        }
+    }
+    fprintf(file, "],\"collider\":%s}%s", collider ? "true" : "false", last ? "" : ",");
+    return !ferror(file);
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <output.json> <width> [height] [layers] [density] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t width = strtoul(argv[2], NULL, 10);
+    uint32_t height = argc > 3 ? strtoul(argv[3], NULL, 10) : width;
+    uint32_t layers = argc > 4 ? strtoul(argv[4], NULL, 10) : 4;
+    uint32_t density = argc > 5 ? strtoul(argv[5], NULL, 10) : 10;
+    random_state = argc > 6 ? strtoul(argv[6], NULL, 10) : 1;
+    if (!random_state) random_state = 1;
+
+    if (!width || !height || width > MAX_MAP_SIZE || height > MAX_MAP_SIZE || !layers || layers > 255 || density > 100)
+    {
+        fprintf(stderr, "Invalid map (%ux%u, %u layers, %u%% density)!\n", width, height, layers, density);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t words = (width + 63) / 64;
+    uint64_t * grid = malloc((size_t) words * height * sizeof(uint64_t));
+    FILE * file = fopen(argv[1], "w");
+    if (!grid || !file)
+    {
+        fprintf(stderr, "Couldn't %s \"%s\"!\n", grid ? "open" : "allocate the tiles of", argv[1]);
+        free(grid);
+        if (file) fclose(file);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(file, "{\"tileSize\":50,\"mapWidth\":%u,\"mapHeight\":%u,\"layers\":[", width, height);
+
+    _Bool success = 1;
+    for (uint32_t layer = 0; layer < layers && success; layer++)
+    {
+        char name[32];
+        _Bool ground = layer == layers - 1;
+
+        if (ground)
+        {
+            // Full layer, the bits past the width are never read
+
+            memset(grid, 0xff, (size_t) words * height * sizeof(uint64_t));
+            snprintf(name, sizeof(name), "Ground");
+        }
+        else
+        {
+            // Average patch is about (MAX_PATCH_SIZE + 1) / 2 squared tiles
+
+            memset(grid, 0, (size_t) words * height * sizeof(uint64_t));
+            uint64_t averagePatch = (MAX_PATCH_SIZE + 1) * (MAX_PATCH_SIZE + 1) / 4;
+            uint64_t patches = (uint64_t) width * height * density / 100 / averagePatch;
+
+            for (uint64_t patch = 0; patch < patches; patch++)
+            {
+                uint32_t patchX = GeneratorRandom() % width, patchY = GeneratorRandom() % height;
+                uint32_t patchWidth = 1 + GeneratorRandom() % MAX_PATCH_SIZE, patchHeight = 1 + GeneratorRandom() % MAX_PATCH_SIZE;
+
+                for (uint32_t y = patchY; y < patchY + patchHeight && y < height; y++)
+                {
+                    for (uint32_t x = patchX; x < patchX + patchWidth && x < width; x++) grid[(size_t) y * words + (x >> 6)] |= 1ull << (x & 63);
+                }
+            }
+            if (layer == 1) snprintf(name, sizeof(name), "Walls");
+            else snprintf(name, sizeof(name), "Decorations_%u", layer);
+        }
+
+        success = ground ? WriteLayer(file, grid, width, height, name, 0, GroundIds, sizeof(GroundIds) / sizeof(GroundIds[0]), 1) :
+                           WriteLayer(file, grid, width, height, name, layer == 1, DecorationIds, sizeof(DecorationIds) / sizeof(DecorationIds[0]), 0);
+    }
+
+    fprintf(file, "]}");
+    success = success && !ferror(file);
+    success = !fclose(file) && success;
+    free(grid);
+
+    if (success) printf("%s (%u layers, %ux%u, %u%% density)\n", argv[1], layers, width, height, density);
+    else fprintf(stderr, "Couldn't write \"%s\"!\n", argv[1]);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,270 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Headless world simulation, runs the update half of PutWorld (and the particle updater) at a fixed dt
+// with a scripted walk around the overworld and reports how many ticks per second the CPU can do
+// Every ZONE_TOUR_INTERVAL ticks Freddy gets teleported into the next zone of the tour (so zone changes and their loads get timed too)
+// Usage: World_Sim [ticks] [dt] [hitch budget in ms] [--record <file> | --replay <file>]
+// Recorded and replayed runs run whole frames and end on a "Result:" line, replays of one recording have to print the same one
+
+#include "Headless/Headless.h"
+#include "../src/World.h"
+#include "../src/Particle.h"
+#include "../src/Save.h"
+#include "../src/Game_State.h"
+#include "../src/input.h"
+#include "../src/rayclock.h"
+#include "../src/Profiler.h"
+#include "../src/Asset_Tracker.h"
+#include "../src/Hitch_Recorder.h"
+#include "../src/Asset_Telemetry.h"
+#include "../src/Alloc_Tracker.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_TICKS 100000
+#define DEFAULT_DT (1 / 240.)
+
+typedef struct ScriptedInput
+{
+    int keys[2];
+    uint32_t ticks;
+} ScriptedInput;
+
+// A loop around Fazbear Hills that bumps into walls on the way (so collision gets exercised too)
+static const ScriptedInput Route[] =
+{
+    {{KEY_D, 0}, 480},
+    {{KEY_S, 0}, 720},
+    {{KEY_S, KEY_A}, 360},
+    {{KEY_A, 0}, 960},
+    {{KEY_W, 0}, 720},
+    {{KEY_W, KEY_D}, 360},
+    {{KEY_D, 0}, 480},
+    {{0, 0}, 120},
+};
+
+#define ROUTE_LENGTH (sizeof(Route) / sizeof(ScriptedInput))
+
+// Holds down the keys of the route step the tick is in
+static void ApplyRoute(uint64_t tick)
+{
+    static uint32_t route_ticks = 0;
+    if (!route_ticks) for (uint8_t i = 0; i < ROUTE_LENGTH; i++) route_ticks += Route[i].ticks;
+
+    uint32_t position = tick % route_ticks;
+    uint8_t step = 0;
+    while (position >= Route[step].ticks) position -= Route[step].ticks, step++;
+
+    ClearHeadlessKeys();
+    SetHeadlessKey(Route[step].keys[0], 1);
+    SetHeadlessKey(Route[step].keys[1], 1);
+}
+
+// Ticks between the teleports of the zone tour
+#define ZONE_TOUR_INTERVAL 2400
+
+extern WORLDEntity Freddy;
+
+// Choppy's Woods, Dusting Fields and Mysterious Mines (their warp targets), the last stop is where the route starts
+static Vector2 ZoneTour[] =
+{
+    {34, 32},
+    {19, 34},
+    {29.15, 71.275},
+    {0, 0},
+};
+
+#define ZONE_TOUR_LENGTH (sizeof(ZoneTour) / sizeof(Vector2))
+
+static uint32_t ZoneTeleports = 0;
+
+// Teleports Freddy to the next stop of the zone tour if the tick is on a ZONE_TOUR_INTERVAL
+static void ApplyZoneTour(uint64_t tick)
+{
+    if (!tick || tick % ZONE_TOUR_INTERVAL) return;
+    Freddy.position = ZoneTour[ZoneTeleports++ % ZONE_TOUR_LENGTH];
+}
+
+static uint32_t ZoneChanges = 0;
+
+static void CountZoneChange(uint8_t exited, uint8_t entered)
+{
+    (void) exited, (void) entered;
+    ZoneChanges++;
+}
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char ** argv)
+{
+    // --record / --replay can go anywhere, the rest are read in order
+
+    const char * record_path = NULL;
+    const char * replay_path = NULL;
+    char * arguments[3] = {0};
+    uint8_t amount_of_arguments = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--record") && i + 1 < argc) record_path = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replay_path = argv[++i];
+        else if (amount_of_arguments < 3) arguments[amount_of_arguments++] = argv[i];
+    }
+
+    uint64_t ticks = arguments[0] ? strtoull(arguments[0], NULL, 10) : DEFAULT_TICKS;
+    float dt = arguments[1] ? strtof(arguments[1], NULL) : DEFAULT_DT;
+
+    SetHeadlessFrameTime(dt);
+
+    ALLOC_TRACKER_INIT();
+
+    // NULL save so the simulation never writes over a real save file
+    // (the allocation check uses a throwaway one in bin/ so WriteSave gets exercised too)
+
+    #ifdef ALLOC_TRACKER
+
+    remove("bin/world_sim_save.json");
+    LoadSave("bin/world_sim_save.json");
+
+    #else
+
+    LoadSave(NULL);
+
+    #endif
+
+    double load_start = GetSeconds();
+    LoadWorldTilemap();
+    double load_end = GetSeconds();
+
+    SwapGameState(World);
+    SubscribeZoneChange(CountZoneChange);
+    ZoneTour[ZONE_TOUR_LENGTH - 1] = Freddy.position;
+
+    // Makes sure the first key press switches input to KEYBOARD
+
+    SetHeadlessKey(KEY_D, 1);
+    BeginInputFrame();
+    RefreshInput();
+    StepHeadlessFrame();
+
+    // Ticks over the normal frame budget (mostly zone asset loads) end up in here
+
+    remove("bin/world_sim_hitches.log");
+    SetHitchLogPath("bin/world_sim_hitches.log");
+    if (arguments[2]) SetHitchBudget(strtod(arguments[2], NULL) / 1000);
+
+    // Same seeding as the game's --record / --replay, a recording made from the time has to replay on its own seed
+
+    if (record_path && !StartInputRecording(record_path, (uint32_t) time(NULL))) return EXIT_FAILURE;
+    if (replay_path && !StartInputReplay(replay_path)) return EXIT_FAILURE;
+    if (record_path || replay_path) SetRandomSeed(GetInputRecordingSeed());
+
+    // The random bird spawns only happen while rendering
+
+    _Bool whole_frames = record_path || replay_path;
+
+    #ifdef ALLOC_TRACKER
+
+    whole_frames = 1;
+
+    #endif
+
+    double start = GetSeconds();
+
+    for (uint64_t tick = 0; tick < ticks; tick++)
+    {
+        ApplyRoute(tick);
+        ApplyZoneTour(tick);
+        BeginHitchFrame();
+        ALLOC_FRAME_BEGIN();
+        BeginInputFrame();
+        UpdateRayclock();
+
+        // The allocation check and recordings need whole frames (rendering included)
+
+        if (whole_frames) PutWorld();
+        else
+        {
+            UpdateWorld();
+            UpdateUIParticles();
+        }
+
+        RefreshInput();
+        ALLOC_FRAME_END();
+        EndHitchFrame();
+        StepHeadlessFrame();
+    }
+
+    double elapsed = GetSeconds() - start;
+    StopInputCapture();
+
+    printf("LoadWorldTilemap: %.3f ms\n", (load_end - load_start) * 1000);
+    printf("Ticks: %llu @ dt %.6f s (%.1f s simulated)\n", (unsigned long long) ticks, dt, ticks * dt);
+    printf("Elapsed: %.3f s\n", elapsed);
+    printf("Ticks per second: %.0f\n", ticks / elapsed);
+    printf("Microseconds per tick: %.3f\n", elapsed * 1e6 / ticks);
+    printf("Final Freddy zone: %u (%u zone changes)\n", GetZone(), ZoneChanges);
+    printf("Zone tour teleports: %u\n", ZoneTeleports);
+    printf("Hitches: %u (see bin/world_sim_hitches.log)\n", GetHitchCount());
+
+    // Everything a replay could end up with differently (the last value shows GetRandomValue got the same seed and draws)
+
+    if (record_path || replay_path)
+    {
+        printf("Result: Freddy %.4f %.4f, zone %u, %u zone changes, %u particles, %u entities visible, random %d\n", 
+                Freddy.position.x, Freddy.position.y, GetZone(), ZoneChanges, GetParticleCount(), 
+                GetVisibleWorldEntityCount(), GetRandomValue(0, 1 << 30));
+    }
+
+    PrintAssetReport();
+    PrintAssetLoadReport();
+
+    PROFILE_EXPORT("bin/world_sim_trace.json");
+
+    // Every stop of the tour is in another zone than the last one, so each teleport has to show up as a zone change
+
+    if (ZoneChanges < ZoneTeleports)
+    {
+        fprintf(stderr, "World_Sim: %u zone changes for %u zone teleports!\n", ZoneChanges, ZoneTeleports);
+        return EXIT_FAILURE;
+    }
+
+    // Fails the run if a steady-state frame allocated (used by make headless_alloc)
+
+    #ifdef ALLOC_TRACKER
+
+    ALLOC_REPORT();
+    if (GetSteadyStateAllocations()) return EXIT_FAILURE;
+
+    #endif
+
+    return 0;
+}
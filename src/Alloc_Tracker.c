@@ -0,0 +1,236 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define ALLOC_TRACKER_IMPLEMENTATION
+
+#include "Alloc_Tracker.h"
+
+#ifdef ALLOC_TRACKER
+
+#include "../Include/cJSON.h"
+#include "Game_State.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sites reported per steady-state frame (the rest are still counted)
+#define MAX_FRAME_SITES 8
+
+// Steady-state frames that allocated which get printed (the rest only show up in the report)
+#define MAX_REPORTED_FRAMES 32
+
+typedef struct AllocSite
+{
+    const char * site;
+    uint64_t allocations;
+    uint64_t steady_allocations; // Made in steady-state frames
+    uint64_t bytes;
+    uint64_t largest;
+} AllocSite;
+
+static AllocSite Sites[MAX_ALLOC_SITES + 1] = {0}; // Last one is "(other)" for when the table is full
+static uint16_t AmountOfSites = 0;
+
+// Workers can allocate too, the counters are tiny so a spinlock is enough
+static atomic_flag AllocLock = ATOMIC_FLAG_INIT;
+
+static uint32_t FrameAllocations = 0;
+static _Atomic uint32_t FrameFrees = 0;
+static uint64_t FrameBytes = 0;
+static AllocSite * FrameSites[MAX_FRAME_SITES] = {0};
+static uint32_t FrameSiteCounts[MAX_FRAME_SITES] = {0};
+static uint8_t AmountOfFrameSites = 0;
+
+static uint64_t Frames = 0;
+static uint64_t SteadyFrames = 0;
+static uint64_t SteadyAllocatingFrames = 0;
+static uint64_t SteadyAllocations = 0;
+static uint64_t TotalAllocations = 0;
+static uint32_t MaxFrameAllocations = 0;
+static uint32_t LastFrameAllocations = 0;
+
+static enum GameStateTypes LastState = -1;
+static uint32_t FramesInState = 0;
+static _Bool SteadyFrame = 0;
+
+// Sites are string literals so the same site always has the same address
+static AllocSite * GetAllocSite(const char * site)
+{
+    uint16_t slot = ((uintptr_t) site >> 3) % MAX_ALLOC_SITES;
+    for (uint16_t i = 0; i < MAX_ALLOC_SITES; i++, slot = (slot + 1) % MAX_ALLOC_SITES)
+    {
+        if (Sites[slot].site == site) return Sites + slot;
+        if (Sites[slot].site) continue;
+
+        Sites[slot].site = site;
+        AmountOfSites++;
+        return Sites + slot;
+    }
+    Sites[MAX_ALLOC_SITES].site = "(other)";
+    return Sites + MAX_ALLOC_SITES;
+}
+
+static void CountAllocation(size_t size, const char * site)
+{
+    while (atomic_flag_test_and_set_explicit(&AllocLock, memory_order_acquire));
+
+    AllocSite * entry = GetAllocSite(site);
+    entry -> allocations++;
+    entry -> bytes += size;
+    if (size > entry -> largest) entry -> largest = size;
+    if (SteadyFrame) entry -> steady_allocations++;
+
+    FrameAllocations++;
+    FrameBytes += size;
+    TotalAllocations++;
+
+    uint8_t i = 0;
+    for (; i < AmountOfFrameSites && FrameSites[i] != entry; i++);
+    if (i < MAX_FRAME_SITES)
+    {
+        if (i == AmountOfFrameSites) FrameSites[AmountOfFrameSites++] = entry, FrameSiteCounts[i] = 0;
+        FrameSiteCounts[i]++;
+    }
+
+    atomic_flag_clear_explicit(&AllocLock, memory_order_release);
+}
+
+void * TrackedMalloc(size_t size, const char * site)
+{
+    CountAllocation(size, site);
+    return malloc(size);
+}
+
+void * TrackedCalloc(size_t count, size_t size, const char * site)
+{
+    CountAllocation(count * size, site);
+    return calloc(count, size);
+}
+
+// Growing / shrinking a block counts as an allocation too (it may move), realloc(block, 0) only counts as a free
+void * TrackedRealloc(void * block, size_t size, const char * site)
+{
+    if (size) CountAllocation(size, site);
+    else if (block) FrameFrees++;
+    return realloc(block, size);
+}
+
+void TrackedFree(void * block)
+{
+    if (block) FrameFrees++;
+    free(block);
+}
+
+static void * CJSONMalloc(size_t size)
+{
+    return TrackedMalloc(size, "cJSON");
+}
+
+// Hooks cJSON's allocations into the tracker, use ALLOC_TRACKER_INIT instead
+void InitAllocTracker(void)
+{
+    cJSON_InitHooks(&(cJSON_Hooks) {CJSONMalloc, TrackedFree});
+}
+
+// Starts counting a new frame, use ALLOC_FRAME_BEGIN instead
+void BeginAllocFrame(void)
+{
+    enum GameStateTypes state = GetGameState();
+    if (state != LastState) LastState = state, FramesInState = 0;
+    else FramesInState++;
+
+    SteadyFrame = (state == World || state == Battle) && FramesInState >= ALLOC_WARMUP_FRAMES;
+
+    FrameAllocations = 0;
+    FrameFrees = 0;
+    FrameBytes = 0;
+    AmountOfFrameSites = 0;
+}
+
+// Finishes counting the frame and reports it if it was a steady-state frame that allocated, use ALLOC_FRAME_END instead
+uint32_t EndAllocFrame(void)
+{
+    Frames++;
+    LastFrameAllocations = FrameAllocations;
+    if (FrameAllocations > MaxFrameAllocations) MaxFrameAllocations = FrameAllocations;
+    if (!SteadyFrame) return 0;
+
+    SteadyFrames++;
+    if (!FrameAllocations) return 0;
+
+    SteadyAllocatingFrames++;
+    SteadyAllocations += FrameAllocations;
+    if (SteadyAllocatingFrames > MAX_REPORTED_FRAMES) return FrameAllocations;
+
+    printf("ALLOC TRACKER: %u allocations (%llu bytes, %u frees) in steady-state %s frame %llu:", FrameAllocations,
+            (unsigned long long) FrameBytes, atomic_load(&FrameFrees), GetGameStateName(LastState), (unsigned long long) Frames - 1);
+    for (uint8_t i = 0; i < AmountOfFrameSites; i++) printf(" %s x%u", FrameSites[i] -> site, FrameSiteCounts[i]);
+    printf("\n");
+
+    return FrameAllocations;
+}
+
+// Gets the amount of allocations made in the last finished frame
+uint32_t GetLastFrameAllocations(void)
+{
+    return LastFrameAllocations;
+}
+
+// Gets the amount of allocations made in every steady-state frame so far
+uint64_t GetSteadyStateAllocations(void)
+{
+    return SteadyAllocations;
+}
+
+static int CompareAllocSites(const void * a, const void * b)
+{
+    const AllocSite * x = a;
+    const AllocSite * y = b;
+    if (x -> steady_allocations != y -> steady_allocations) return (x -> steady_allocations < y -> steady_allocations) - (x -> steady_allocations > y -> steady_allocations);
+    return (x -> allocations < y -> allocations) - (x -> allocations > y -> allocations);
+}
+
+// Prints allocations per call site and per frame, use ALLOC_REPORT instead
+void PrintAllocReport(void)
+{
+    printf("\nAllocation report:\n");
+    printf("  %llu allocations over %llu frames (max %u in one frame)\n", (unsigned long long) TotalAllocations,
+            (unsigned long long) Frames, MaxFrameAllocations);
+    printf("  Steady-state frames: %llu, %llu of them allocated (%llu allocations)%s\n", (unsigned long long) SteadyFrames,
+            (unsigned long long) SteadyAllocatingFrames, (unsigned long long) SteadyAllocations, SteadyAllocations ? "  FAIL" : "");
+
+    static AllocSite sorted[MAX_ALLOC_SITES + 1];
+    uint16_t amount = 0;
+    for (uint16_t i = 0; i <= MAX_ALLOC_SITES; i++) if (Sites[i].site) sorted[amount++] = Sites[i];
+    qsort(sorted, amount, sizeof(AllocSite), CompareAllocSites);
+
+    printf("  Per call site (steady-state allocations first):\n");
+    for (uint16_t i = 0; i < amount; i++)
+    {
+        printf("    %8llu steady, %8llu total, %10.1f KB total, largest %8llu B  %s\n", (unsigned long long) sorted[i].steady_allocations,
+                (unsigned long long) sorted[i].allocations, sorted[i].bytes / 1024., (unsigned long long) sorted[i].largest, sorted[i].site);
+    }
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Heap allocation tracker, only compiled in when building with -DALLOC_TRACKER
+// Every source file that includes this header gets malloc / calloc / realloc / free routed through the tracker, tagged with
+// the file and line of the call (cJSON's allocations are hooked in too and tagged "cJSON"). Allocations are counted per frame
+// and every allocation made in a steady-state World or Battle frame is reported, the goal is zero of them
+// Allocations made inside Raylib aren't seen (it's a prebuilt library)
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Frames after a game state swap that aren't steady-state yet (the new state is still loading / warming up)
+#define ALLOC_WARMUP_FRAMES 120
+
+// Call sites tracked separately, the rest are counted as "(other)"
+#define MAX_ALLOC_SITES 256
+
+#ifdef ALLOC_TRACKER
+
+#define ALLOC_STRINGIFY_(x) #x
+#define ALLOC_STRINGIFY(x) ALLOC_STRINGIFY_(x)
+#define ALLOC_SITE __FILE__ ":" ALLOC_STRINGIFY(__LINE__)
+
+// Hooks cJSON's allocations into the tracker, call before anything is parsed
+#define ALLOC_TRACKER_INIT() InitAllocTracker()
+
+// Starts counting a new frame
+#define ALLOC_FRAME_BEGIN() BeginAllocFrame()
+
+// Finishes counting the frame and reports it if it was a steady-state frame that allocated
+#define ALLOC_FRAME_END() EndAllocFrame()
+
+// Prints allocations per call site and per frame
+#define ALLOC_REPORT() PrintAllocReport()
+
+extern void * TrackedMalloc(size_t size, const char * site);
+extern void * TrackedCalloc(size_t count, size_t size, const char * site);
+extern void * TrackedRealloc(void * block, size_t size, const char * site);
+extern void TrackedFree(void * block);
+
+// Hooks cJSON's allocations into the tracker, use ALLOC_TRACKER_INIT instead
+extern void InitAllocTracker(void);
+
+// Starts counting a new frame, use ALLOC_FRAME_BEGIN instead
+extern void BeginAllocFrame(void);
+
+// Finishes counting the frame and reports it if it was a steady-state frame that allocated, use ALLOC_FRAME_END instead
+// Returns the amount of allocations made if it was a steady-state frame (0 if it wasn't)
+extern uint32_t EndAllocFrame(void);
+
+// Gets the amount of allocations made in the last finished frame
+extern uint32_t GetLastFrameAllocations(void);
+
+// Gets the amount of allocations made in every steady-state frame so far
+extern uint64_t GetSteadyStateAllocations(void);
+
+// Prints allocations per call site and per frame, use ALLOC_REPORT instead
+extern void PrintAllocReport(void);
+
+#ifndef ALLOC_TRACKER_IMPLEMENTATION
+
+// Included first so their declarations don't get caught by the macros below
+#include <malloc.h>
+
+#define malloc(size) TrackedMalloc(size, ALLOC_SITE)
+#define calloc(count, size) TrackedCalloc(count, size, ALLOC_SITE)
+#define realloc(block, size) TrackedRealloc(block, size, ALLOC_SITE)
+#define free(block) TrackedFree(block)
+
+#endif
+
+#else
+
+#define ALLOC_TRACKER_INIT()
+#define ALLOC_FRAME_BEGIN()
+#define ALLOC_FRAME_END()
+#define ALLOC_REPORT()
+
+#endif
@@ -24,6 +24,8 @@
 #include "Animation.h"
 #include "UI.h"
 #include "types.h"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
 #include <malloc.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,11 +33,13 @@
 #include <stdio.h>
 #include <memory.h>
 #include <time.h>
+#include "rayclock.h"
+#include "Alloc_Tracker.h"
 
 // Gets current animation frame from clock_t, entered frames, and entered FPS (used by UIanimationV2)
 uint16_t GetCurrentAnimationFrameC(clock_t startTime, uint16_t frames, uint8_t FPS)
 {
-    float currentFrame =  (float)(clock() - startTime) / CLOCKS_PER_SEC;
+    float currentFrame =  (float)(Rayclock() - startTime) / CLOCKS_PER_SEC;
     currentFrame /= 1. / FPS;
     return (uint16_t) currentFrame % frames;
 }
@@ -86,7 +90,7 @@ uint16_t GetFrameAmount(const char * directory)
 // Gets current animation frame from an animation struct
 uint16_t GetCurrentAnimationFrame(const Animation * animation)
 {
-    float currentFrame =  (float)(clock() - animation -> Clock) / CLOCKS_PER_SEC;
+    float currentFrame =  (float)(Rayclock() - animation -> Clock) / CLOCKS_PER_SEC;
     currentFrame /= 1. / animation -> FPS;
     return (uint16_t)currentFrame % animation -> Amount;
 }
@@ -158,7 +162,7 @@ Animation_V2 CreateAnimation_V2(const char * path, const uint8_t targetFPS, cons
     animation.Atlas = LoadTexture(path);
     SetTextureFilter(animation.Atlas, TEXTURE_FILTER_BILINEAR);
     animation.Amount = amount;
-    animation.Clock = clock();
+    animation.Clock = Rayclock();
     animation.FPS = targetFPS;
     animation.TileSize_x = tileSize_x;
     animation.TileSize_y = tileSize_y;
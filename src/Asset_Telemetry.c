@@ -0,0 +1,229 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Asset_Telemetry.h"
+#include "Game_State.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_OF_TIMED_STATES (NUMBER_OF_GAME_STATES + 1) // Last one is for unknown / invalid game states (and startup)
+
+// One per file per load site
+typedef struct AssetLoadRecord
+{
+    char * path;
+    const char * site;
+    const char * kind;
+    uint32_t loads;
+    uint64_t slowest; // Nanoseconds
+    AssetLoadTiming total;
+} AssetLoadRecord;
+
+static AssetLoadRecord * Records = NULL;
+static uint32_t AmountOfRecords = 0;
+static uint32_t RecordsCapacity = 0;
+
+static AssetLoadTiming StateTotals[NUMBER_OF_TIMED_STATES] = {0};
+static uint32_t StateLoads[NUMBER_OF_TIMED_STATES] = {0};
+
+static uint64_t GetTotalTime(const AssetLoadTiming * timing)
+{
+    return timing -> read + timing -> decode + timing -> upload;
+}
+
+static void AddTiming(AssetLoadTiming * total, const AssetLoadTiming * timing)
+{
+    total -> read += timing -> read;
+    total -> decode += timing -> decode;
+    total -> upload += timing -> upload;
+    total -> file_bytes += timing -> file_bytes;
+    total -> decoded_bytes += timing -> decoded_bytes;
+    total -> uploaded_bytes += timing -> uploaded_bytes;
+}
+
+static AssetLoadRecord * GetAssetLoadRecord(const char * path, const char * site, const char * kind)
+{
+    for (uint32_t i = 0; i < AmountOfRecords; i++)
+    {
+        if (Records[i].site == site && !strcmp(Records[i].path, path)) return Records + i;
+    }
+
+    if (AmountOfRecords == RecordsCapacity)
+    {
+        uint32_t capacity = RecordsCapacity ? RecordsCapacity * 2 : 128;
+        AssetLoadRecord * resized = realloc(Records, capacity * sizeof(AssetLoadRecord));
+        if (!resized) return NULL;
+        Records = resized;
+        RecordsCapacity = capacity;
+    }
+
+    char * path_copy = malloc(strlen(path) + 1);
+    if (!path_copy) return NULL;
+    strcpy(path_copy, path);
+
+    Records[AmountOfRecords] = (AssetLoadRecord) {path_copy, site, kind, 0, 0, {0}};
+    return Records + AmountOfRecords++;
+}
+
+// Adds a load to the telemetry (site has to be a string that lives forever, like __func__)
+void RecordAssetLoad(const char * path, const char * site, const char * kind, enum GameStateTypes state, AssetLoadTiming timing)
+{
+    uint8_t i = (unsigned) state < NUMBER_OF_GAME_STATES ? state : NUMBER_OF_TIMED_STATES - 1;
+    AddTiming(StateTotals + i, &timing);
+    StateLoads[i]++;
+
+    AssetLoadRecord * record = GetAssetLoadRecord(path, site ? site : "?", kind);
+    if (!record)
+    {
+        printf("ASSET TELEMETRY: Couldn't record \"%s\"!\n", path);
+        return;
+    }
+
+    AddTiming(&record -> total, &timing);
+    record -> loads++;
+    if (GetTotalTime(&timing) > record -> slowest) record -> slowest = GetTotalTime(&timing);
+}
+
+static int CompareRecordTimes(const void * a, const void * b)
+{
+    uint64_t x = GetTotalTime(&((const AssetLoadRecord *) a) -> total);
+    uint64_t y = GetTotalTime(&((const AssetLoadRecord *) b) -> total);
+    return (x < y) - (x > y);
+}
+
+static int CompareRecordPaths(const void * a, const void * b)
+{
+    return strcmp(((const AssetLoadRecord *) a) -> path, ((const AssetLoadRecord *) b) -> path);
+}
+
+static int CompareRecordSites(const void * a, const void * b)
+{
+    return strcmp(((const AssetLoadRecord *) a) -> site, ((const AssetLoadRecord *) b) -> site);
+}
+
+// Merges sorted neighbours that compare equal into one record, returns the new amount
+static uint32_t MergeRecords(AssetLoadRecord * records, uint32_t amount, int (* compare)(const void *, const void *))
+{
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        if (merged && !compare(records + merged - 1, records + i))
+        {
+            AssetLoadRecord * into = records + merged - 1;
+            AddTiming(&into -> total, &records[i].total);
+            into -> loads += records[i].loads;
+            if (records[i].slowest > into -> slowest) into -> slowest = records[i].slowest;
+        }
+        else records[merged++] = records[i];
+    }
+    return merged;
+}
+
+#define MS(ns) ((ns) / 1000000.)
+#define MB(bytes) ((bytes) / (1024. * 1024.))
+
+static void WriteTimingColumns(FILE * file, const AssetLoadTiming * timing)
+{
+    fprintf(file, "%9.2f ms (read %8.2f, decode %8.2f, upload %8.2f)", MS(GetTotalTime(timing)), MS(timing -> read), MS(timing -> decode), MS(timing -> upload));
+}
+
+static void WriteAssetLoadReport(FILE * file)
+{
+    AssetLoadTiming total = {0};
+    uint32_t loads = 0;
+    for (uint8_t i = 0; i < NUMBER_OF_TIMED_STATES; i++) AddTiming(&total, StateTotals + i), loads += StateLoads[i];
+
+    fprintf(file, "\nAsset load report (slowest first):\n  Total: %u loads ", loads);
+    WriteTimingColumns(file, &total);
+    fprintf(file, ", %.2f MB read, %.2f MB decoded, %.2f MB uploaded\n", MB(total.file_bytes), MB(total.decoded_bytes), MB(total.uploaded_bytes));
+
+    fprintf(file, "  Per game state:\n");
+    for (uint8_t i = 0; i < NUMBER_OF_TIMED_STATES; i++)
+    {
+        if (!StateLoads[i]) continue;
+        fprintf(file, "    %-14s %5u loads ", GetGameStateName(i), StateLoads[i]);
+        WriteTimingColumns(file, StateTotals + i);
+        fprintf(file, "\n");
+    }
+
+    if (!AmountOfRecords) return;
+
+    AssetLoadRecord * sorted = malloc(AmountOfRecords * sizeof(AssetLoadRecord));
+    if (!sorted) return;
+
+    // Per load site
+
+    memcpy(sorted, Records, AmountOfRecords * sizeof(AssetLoadRecord));
+    qsort(sorted, AmountOfRecords, sizeof(AssetLoadRecord), CompareRecordSites);
+    uint32_t amount = MergeRecords(sorted, AmountOfRecords, CompareRecordSites);
+    qsort(sorted, amount, sizeof(AssetLoadRecord), CompareRecordTimes);
+
+    fprintf(file, "  Per load site:\n");
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        fprintf(file, "    %-32s %5u loads ", sorted[i].site, sorted[i].loads);
+        WriteTimingColumns(file, &sorted[i].total);
+        fprintf(file, ", %.2f MB read\n", MB(sorted[i].total.file_bytes));
+    }
+
+    // Per file, whichever site loaded it
+
+    memcpy(sorted, Records, AmountOfRecords * sizeof(AssetLoadRecord));
+    qsort(sorted, AmountOfRecords, sizeof(AssetLoadRecord), CompareRecordPaths);
+    amount = MergeRecords(sorted, AmountOfRecords, CompareRecordPaths);
+    qsort(sorted, amount, sizeof(AssetLoadRecord), CompareRecordTimes);
+
+    fprintf(file, "  Per file:\n");
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        fprintf(file, "    ");
+        WriteTimingColumns(file, &sorted[i].total);
+        fprintf(file, " %3ux, slowest %7.2f ms, %8.3f MB file, %8.3f MB decoded  %-14s %s\n", sorted[i].loads, MS(sorted[i].slowest),
+                MB(sorted[i].total.file_bytes), MB(sorted[i].total.decoded_bytes), sorted[i].kind, sorted[i].path);
+    }
+
+    free(sorted);
+}
+
+// Prints the load report (slowest first) to stdout
+void PrintAssetLoadReport(void)
+{
+    WriteAssetLoadReport(stdout);
+}
+
+// Writes the load report (slowest first) to (path), returns 0 on failure
+_Bool SaveAssetLoadReport(const char * path)
+{
+    FILE * file = fopen(path, "w");
+    if (!file)
+    {
+        printf("ASSET TELEMETRY: Couldn't create \"%s\"!\n", path);
+        return 0;
+    }
+    WriteAssetLoadReport(file);
+    fclose(file);
+
+    printf("ASSET TELEMETRY: Wrote load report to \"%s\"\n", path);
+    return 1;
+}
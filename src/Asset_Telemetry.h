@@ -0,0 +1,48 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Asset load telemetry, every load going through the asset tracker is split into its file read, decode (image / audio / font)
+// and upload (GPU texture / audio buffer) time with the bytes each step produced, and summed up per game state, per load site
+// (the function that called LoadTexture etc.) and per file into a report sorted by time
+
+#pragma once
+
+#include "Game_State.h"
+#include <stdint.h>
+
+#define ASSET_LOAD_REPORT_PATH "asset_loads.txt"
+#define ASSET_LOAD_REPORT_KEY KEY_F10
+
+typedef struct AssetLoadTiming
+{
+    uint64_t read, decode, upload; // Nanoseconds
+    uint64_t file_bytes, decoded_bytes, uploaded_bytes;
+} AssetLoadTiming;
+
+// Adds a load to the telemetry (site has to be a string that lives forever, like __func__)
+extern void RecordAssetLoad(const char * path, const char * site, const char * kind, enum GameStateTypes state, AssetLoadTiming timing);
+
+// Prints the load report (slowest first) to stdout
+extern void PrintAssetLoadReport(void);
+
+// Writes the load report (slowest first) to (path), returns 0 on failure
+extern _Bool SaveAssetLoadReport(const char * path);
@@ -0,0 +1,480 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define ASSET_TRACKER_IMPLEMENTATION
+
+#include "Asset_Tracker.h"
+#include "Game_State.h"
+#include "Hitch_Recorder.h"
+#include "Asset_Telemetry.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_OF_TRACKED_STATES (NUMBER_OF_GAME_STATES + 1) // Last one is for unknown / invalid game states
+
+// Raylib streams music through two sub-buffers, this is the usual size of one
+#define MUSIC_STREAM_BUFFER_FRAMES 4096
+
+static const char * AssetKindNames[NUMBER_OF_ASSET_KINDS] =
+{
+    "texture", "render texture", "font", "sound", "music"
+};
+
+typedef struct TrackedAsset
+{
+    uint64_t key; // OpenGL texture id for textures / fonts, audio buffer address for sounds / music
+    uint64_t bytes; // Estimated resident size
+    uint64_t decoded_bytes; // Size of the fully decoded PCM data (only differs from bytes for streamed music)
+    char * path;
+    const char * subsystem;
+    uint8_t kind;
+} TrackedAsset;
+
+static TrackedAsset * Assets = NULL;
+static uint32_t AmountOfAssets = 0;
+static uint32_t AssetsCapacity = 0;
+
+static uint64_t KindBytes[NUMBER_OF_ASSET_KINDS] = {0};
+static uint32_t KindCounts[NUMBER_OF_ASSET_KINDS] = {0};
+
+static uint8_t AssetState = NUMBER_OF_TRACKED_STATES - 1;
+static uint64_t HighWaterMarks[NUMBER_OF_TRACKED_STATES] = {0};
+
+static _Bool IsAudioKind(uint8_t kind)
+{
+    return kind == ASSET_SOUND || kind == ASSET_MUSIC;
+}
+
+static uint64_t GetLiveBytes(void)
+{
+    uint64_t bytes = 0;
+    for (uint8_t i = 0; i < NUMBER_OF_ASSET_KINDS; i++) bytes += KindBytes[i];
+    return bytes;
+}
+
+static void UpdateHighWaterMark(void)
+{
+    uint64_t live = GetLiveBytes();
+    if (live > HighWaterMarks[AssetState]) HighWaterMarks[AssetState] = live;
+}
+
+// Gets the subsystem that owns a game state's assets
+static const char * GetGameStateSubsystem(uint8_t state)
+{
+    switch (state)
+    {
+        case Title:
+            return "Title_Screen";
+        case NUMBER_OF_TRACKED_STATES - 1:
+            return "Main";
+        default:
+            return GetGameStateName(state);
+    }
+}
+
+static void TrackAsset(uint8_t kind, uint64_t key, uint64_t bytes, uint64_t decoded_bytes, const char * path, const char * subsystem)
+{
+    if (!key) return;
+
+    if (AmountOfAssets == AssetsCapacity)
+    {
+        uint32_t capacity = AssetsCapacity ? AssetsCapacity * 2 : 128;
+        TrackedAsset * resized = realloc(Assets, capacity * sizeof(TrackedAsset));
+        if (!resized)
+        {
+            printf("ASSET TRACKER: Couldn't track \"%s\"!\n", path);
+            return;
+        }
+        Assets = resized;
+        AssetsCapacity = capacity;
+    }
+
+    char * path_copy = malloc(strlen(path) + 1);
+    if (!path_copy)
+    {
+        printf("ASSET TRACKER: Couldn't track \"%s\"!\n", path);
+        return;
+    }
+    strcpy(path_copy, path);
+
+    Assets[AmountOfAssets++] = (TrackedAsset) {key, bytes, decoded_bytes, path_copy, subsystem ? subsystem : GetGameStateSubsystem(AssetState), kind};
+
+    KindBytes[kind] += bytes;
+    KindCounts[kind]++;
+    UpdateHighWaterMark();
+}
+
+static void UntrackAsset(_Bool audio, uint64_t key)
+{
+    if (!key) return;
+
+    for (uint32_t i = 0; i < AmountOfAssets; i++)
+    {
+        if (Assets[i].key != key || IsAudioKind(Assets[i].kind) != audio) continue;
+
+        KindBytes[Assets[i].kind] -= Assets[i].bytes;
+        KindCounts[Assets[i].kind]--;
+        free(Assets[i].path);
+
+        Assets[i] = Assets[--AmountOfAssets];
+        return;
+    }
+}
+
+// Gets the size of a texture and all of its mipmaps in bytes
+static uint64_t GetTextureBytes(Texture2D texture)
+{
+    uint64_t bytes = 0;
+    int width = texture.width, height = texture.height;
+    for (int i = 0; i < (texture.mipmaps > 0 ? texture.mipmaps : 1); i++)
+    {
+        bytes += GetPixelDataSize(width, height, texture.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+static uint64_t GetPCMBytes(AudioStream stream, uint64_t frames)
+{
+    return frames * stream.channels * (stream.sampleSize / 8);
+}
+
+// Hands a finished load to the hitch recorder and the load telemetry
+static void FinishAssetLoad(enum HitchEventTypes hitch, const char * path, const char * site, uint8_t kind, AssetLoadTiming timing)
+{
+    RecordHitchEvent(hitch, path, timing.read + timing.decode + timing.upload);
+    RecordAssetLoad(path, site, AssetKindNames[kind], AssetState, timing);
+}
+
+// Same as Raylib's LoadTexture (LoadFileData -> LoadImageFromMemory -> LoadTextureFromImage) but with each step timed
+Texture2D TrackedLoadTexture(const char * fileName, const char * subsystem, const char * site)
+{
+    AssetLoadTiming timing = {0};
+    uint64_t start = GetHitchTimestamp();
+
+    int size = 0;
+    unsigned char * data = LoadFileData(fileName, &size);
+    uint64_t read = GetHitchTimestamp();
+
+    Image image = {0};
+    if (data) image = LoadImageFromMemory(GetFileExtension(fileName), data, size);
+    UnloadFileData(data);
+    uint64_t decoded = GetHitchTimestamp();
+
+    Texture2D texture = LoadTextureFromImage(image);
+    timing.upload = GetHitchTimestamp() - decoded;
+    UnloadImage(image);
+
+    timing.read = read - start;
+    timing.decode = decoded - read;
+    timing.file_bytes = size;
+    timing.decoded_bytes = image.width ? GetPixelDataSize(image.width, image.height, image.format) : 0;
+    timing.uploaded_bytes = GetTextureBytes(texture);
+    FinishAssetLoad(HITCH_ASSET_LOAD, fileName, site, ASSET_TEXTURE, timing);
+
+    TrackAsset(ASSET_TEXTURE, texture.id, timing.uploaded_bytes, timing.uploaded_bytes, fileName, subsystem);
+    return texture;
+}
+
+// Same as Raylib's LoadTextureFromImage, for textures made at runtime (like the overworld's sprite sheet atlas)
+Texture2D TrackedLoadTextureFromImage(Image image, const char * subsystem, const char * site)
+{
+    uint64_t start = GetHitchTimestamp();
+    Texture2D texture = LoadTextureFromImage(image);
+    uint64_t duration = GetHitchTimestamp() - start;
+
+    char name[32];
+    snprintf(name, sizeof(name), "<image %dx%d>", image.width, image.height);
+
+    uint64_t bytes = GetTextureBytes(texture);
+    FinishAssetLoad(HITCH_ASSET_LOAD, name, site, ASSET_TEXTURE, (AssetLoadTiming) {.upload = duration, .uploaded_bytes = bytes});
+
+    TrackAsset(ASSET_TEXTURE, texture.id, bytes, bytes, name, subsystem);
+    return texture;
+}
+
+RenderTexture2D TrackedLoadRenderTexture(int width, int height, const char * subsystem, const char * site)
+{
+    uint64_t start = GetHitchTimestamp();
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    uint64_t duration = GetHitchTimestamp() - start;
+
+    // Raylib gives render textures a 24 bit depth renderbuffer, which drivers pad to 32 bits
+
+    char name[32];
+    snprintf(name, sizeof(name), "<render texture %dx%d>", width, height);
+
+    uint64_t bytes = GetTextureBytes(target.texture) + (uint64_t) width * height * 4;
+    FinishAssetLoad(HITCH_ASSET_LOAD, name, site, ASSET_RENDER_TEXTURE, (AssetLoadTiming) {.upload = duration, .uploaded_bytes = bytes});
+
+    TrackAsset(ASSET_RENDER_TEXTURE, target.texture.id, bytes, bytes, name, subsystem);
+    return target;
+}
+
+// Raylib's defaults for LoadFont (not exported by raylib.h)
+#define FONT_TTF_DEFAULT_SIZE 32
+#define FONT_TTF_DEFAULT_NUMCHARS 95
+
+// Same as Raylib's LoadFont with the file read timed on its own for TTF / OTF fonts
+// (glyph rasterizing and the atlas upload happen inside one Raylib call, so both count as decode)
+// Fonts keep their glyph images and rectangles in RAM next to the atlas
+Font TrackedLoadFont(const char * fileName, const char * subsystem, const char * site)
+{
+    AssetLoadTiming timing = {0};
+    uint64_t start = GetHitchTimestamp();
+    uint64_t read = start;
+    Font font = {0};
+
+    if (IsFileExtension(fileName, ".ttf") || IsFileExtension(fileName, ".otf"))
+    {
+        int size = 0;
+        unsigned char * data = LoadFileData(fileName, &size);
+        read = GetHitchTimestamp();
+        timing.file_bytes = size;
+
+        if (data) font = LoadFontFromMemory(GetFileExtension(fileName), data, size, FONT_TTF_DEFAULT_SIZE, NULL, FONT_TTF_DEFAULT_NUMCHARS);
+        UnloadFileData(data);
+        if (!IsTextureValid(font.texture)) font = GetFontDefault();
+    }
+    else
+    {
+        timing.file_bytes = GetFileLength(fileName);
+        font = LoadFont(fileName);
+    }
+
+    timing.read = read - start;
+    timing.decode = GetHitchTimestamp() - read;
+
+    uint64_t bytes = GetTextureBytes(font.texture);
+    if (font.recs) bytes += font.glyphCount * sizeof(Rectangle);
+    if (font.glyphs)
+    {
+        bytes += font.glyphCount * sizeof(GlyphInfo);
+        for (int i = 0; i < font.glyphCount; i++)
+        {
+            bytes += GetPixelDataSize(font.glyphs[i].image.width, font.glyphs[i].image.height, font.glyphs[i].image.format);
+        }
+    }
+
+    timing.decoded_bytes = bytes;
+    timing.uploaded_bytes = GetTextureBytes(font.texture);
+    FinishAssetLoad(HITCH_ASSET_LOAD, fileName, site, ASSET_FONT, timing);
+
+    TrackAsset(ASSET_FONT, font.texture.id, bytes, bytes, fileName, subsystem);
+    return font;
+}
+
+// Same as Raylib's LoadSound (LoadFileData -> LoadWaveFromMemory -> LoadSoundFromWave) but with each step timed,
+// sounds are fully decoded into PCM when loaded and "upload" is the conversion into an audio buffer
+Sound TrackedLoadSound(const char * fileName, const char * subsystem, const char * site)
+{
+    AssetLoadTiming timing = {0};
+    uint64_t start = GetHitchTimestamp();
+
+    int size = 0;
+    unsigned char * data = LoadFileData(fileName, &size);
+    uint64_t read = GetHitchTimestamp();
+
+    Wave wave = {0};
+    if (data) wave = LoadWaveFromMemory(GetFileExtension(fileName), data, size);
+    UnloadFileData(data);
+    uint64_t decoded = GetHitchTimestamp();
+
+    Sound sound = LoadSoundFromWave(wave);
+    timing.upload = GetHitchTimestamp() - decoded;
+    UnloadWave(wave);
+
+    timing.read = read - start;
+    timing.decode = decoded - read;
+    timing.file_bytes = size;
+    timing.decoded_bytes = (uint64_t) wave.frameCount * wave.channels * (wave.sampleSize / 8);
+    timing.uploaded_bytes = GetPCMBytes(sound.stream, sound.frameCount);
+    FinishAssetLoad(HITCH_ASSET_LOAD, fileName, site, ASSET_SOUND, timing);
+
+    TrackAsset(ASSET_SOUND, (uintptr_t) sound.stream.buffer, timing.uploaded_bytes, timing.uploaded_bytes, fileName, subsystem);
+    return sound;
+}
+
+// Music only keeps its stream buffers decoded, the rest is read from the file as it plays,
+// so opening one is timed as decode (reading the header and starting the decoder)
+Music TrackedLoadMusicStream(const char * fileName, const char * subsystem, const char * site)
+{
+    uint64_t start = GetHitchTimestamp();
+    Music music = LoadMusicStream(fileName);
+    uint64_t duration = GetHitchTimestamp() - start;
+
+    uint64_t bytes = GetPCMBytes(music.stream, MUSIC_STREAM_BUFFER_FRAMES * 2);
+    FinishAssetLoad(HITCH_MUSIC_OPEN, fileName, site, ASSET_MUSIC,
+                    (AssetLoadTiming) {.decode = duration, .file_bytes = GetFileLength(fileName), .decoded_bytes = bytes, .uploaded_bytes = bytes});
+
+    TrackAsset( ASSET_MUSIC, (uintptr_t) music.stream.buffer, bytes,
+                GetPCMBytes(music.stream, music.frameCount),
+                fileName, subsystem);
+    return music;
+}
+
+void TrackedUnloadTexture(Texture2D texture)
+{
+    UntrackAsset(0, texture.id);
+    UnloadTexture(texture);
+}
+
+void TrackedUnloadRenderTexture(RenderTexture2D target)
+{
+    UntrackAsset(0, target.texture.id);
+    UnloadRenderTexture(target);
+}
+
+void TrackedUnloadFont(Font font)
+{
+    UntrackAsset(0, font.texture.id);
+    UnloadFont(font);
+}
+
+void TrackedUnloadSound(Sound sound)
+{
+    UntrackAsset(1, (uintptr_t) sound.stream.buffer);
+    UnloadSound(sound);
+}
+
+void TrackedUnloadMusicStream(Music music)
+{
+    UntrackAsset(1, (uintptr_t) music.stream.buffer);
+    UnloadMusicStream(music);
+}
+
+// Tells the tracker which game state assets are being loaded for (called by SwapGameState before initializing the new state)
+void SetAssetGameState(enum GameStateTypes state)
+{
+    AssetState = (unsigned) state < NUMBER_OF_GAME_STATES ? state : NUMBER_OF_TRACKED_STATES - 1;
+    UpdateHighWaterMark();
+}
+
+// Gets the estimated amount of bytes used by every currently loaded texture (textures, render textures and font atlases)
+uint64_t GetTrackedTextureMemory(void)
+{
+    return KindBytes[ASSET_TEXTURE] + KindBytes[ASSET_RENDER_TEXTURE] + KindBytes[ASSET_FONT];
+}
+
+// Gets the amount of textures currently loaded (textures, render textures and font atlases)
+uint32_t GetTrackedTextureCount(void)
+{
+    return KindCounts[ASSET_TEXTURE] + KindCounts[ASSET_RENDER_TEXTURE] + KindCounts[ASSET_FONT];
+}
+
+// Gets the estimated amount of bytes used by every currently loaded sound and music stream
+uint64_t GetTrackedAudioMemory(void)
+{
+    return KindBytes[ASSET_SOUND] + KindBytes[ASSET_MUSIC];
+}
+
+// Gets the highest amount of tracked bytes (textures + audio) seen while in a game state
+uint64_t GetAssetHighWaterMark(enum GameStateTypes state)
+{
+    return HighWaterMarks[(unsigned) state < NUMBER_OF_GAME_STATES ? state : NUMBER_OF_TRACKED_STATES - 1];
+}
+
+static int CompareAssetBytes(const void * a, const void * b)
+{
+    const TrackedAsset * x = a;
+    const TrackedAsset * y = b;
+    return (x -> bytes < y -> bytes) - (x -> bytes > y -> bytes);
+}
+
+static int CompareAssetPaths(const void * a, const void * b)
+{
+    return strcmp(((const TrackedAsset *) a) -> path, ((const TrackedAsset *) b) -> path);
+}
+
+#define MB(bytes) ((bytes) / (1024. * 1024.))
+
+// Prints live totals per subsystem, high-water marks per game state, every live asset and files loaded more than once
+void PrintAssetReport(void)
+{
+    uint64_t live = GetLiveBytes();
+
+    printf("\nAsset memory report:\n");
+    printf("  Live: %.2f MB of the %.0f MB budget (%u textures %.2f MB, %u audio %.2f MB)\n",
+            MB(live), MB(ASSET_MEMORY_BUDGET),
+            GetTrackedTextureCount(), MB(GetTrackedTextureMemory()),
+            KindCounts[ASSET_SOUND] + KindCounts[ASSET_MUSIC], MB(GetTrackedAudioMemory()));
+
+    // Live bytes per subsystem
+
+    const char * subsystems[32] = {0};
+    uint64_t subsystem_bytes[32][2] = {0};
+    uint8_t amount_of_subsystems = 0;
+
+    for (uint32_t i = 0; i < AmountOfAssets; i++)
+    {
+        uint8_t s = 0;
+        for (; s < amount_of_subsystems && strcmp(subsystems[s], Assets[i].subsystem); s++);
+        if (s == 32) continue;
+        if (s == amount_of_subsystems) subsystems[amount_of_subsystems++] = Assets[i].subsystem;
+        subsystem_bytes[s][IsAudioKind(Assets[i].kind)] += Assets[i].bytes;
+    }
+
+    printf("  Live per subsystem:\n");
+    for (uint8_t s = 0; s < amount_of_subsystems; s++)
+    {
+        printf("    %-14s textures %8.2f MB, audio %8.2f MB\n", subsystems[s], MB(subsystem_bytes[s][0]), MB(subsystem_bytes[s][1]));
+    }
+
+    printf("  High-water mark per game state:\n");
+    for (uint8_t i = 0; i < NUMBER_OF_TRACKED_STATES; i++)
+    {
+        if (!HighWaterMarks[i]) continue;
+        printf("    %-14s %8.2f MB%s\n", GetGameStateName(i), MB(HighWaterMarks[i]), HighWaterMarks[i] > ASSET_MEMORY_BUDGET ? "  OVER BUDGET" : "");
+    }
+
+    if (!AmountOfAssets) return;
+
+    TrackedAsset * sorted = malloc(AmountOfAssets * sizeof(TrackedAsset));
+    if (!sorted) return;
+    memcpy(sorted, Assets, AmountOfAssets * sizeof(TrackedAsset));
+
+    printf("  Live assets (largest first):\n");
+    qsort(sorted, AmountOfAssets, sizeof(TrackedAsset), CompareAssetBytes);
+    for (uint32_t i = 0; i < AmountOfAssets; i++)
+    {
+        printf("    %8.2f MB  %-14s %-14s %s", MB(sorted[i].bytes), AssetKindNames[sorted[i].kind], sorted[i].subsystem, sorted[i].path);
+        if (sorted[i].decoded_bytes != sorted[i].bytes) printf(" (%.2f MB decoded)", MB(sorted[i].decoded_bytes));
+        printf("\n");
+    }
+
+    // The same file being live more than once is almost always a reload that forgot to unload
+
+    printf("  Files loaded more than once (still live):\n");
+    qsort(sorted, AmountOfAssets, sizeof(TrackedAsset), CompareAssetPaths);
+    for (uint32_t i = 0; i < AmountOfAssets;)
+    {
+        uint32_t j = i + 1;
+        for (; j < AmountOfAssets && !strcmp(sorted[i].path, sorted[j].path); j++);
+        if (j - i > 1 && sorted[i].kind != ASSET_RENDER_TEXTURE) printf("    %ux  %s (%s)\n", j - i, sorted[i].path, sorted[i].subsystem);
+        i = j;
+    }
+
+    free(sorted);
+}
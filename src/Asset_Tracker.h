@@ -0,0 +1,98 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Keeps track of every loaded texture, render texture, font, sound and music stream: its size, the file it came from and
+// the subsystem that owns it, with live totals and a high-water mark per game state
+// Any source file that includes this header (after Raylib) gets its loads / unloads routed through the tracker,
+// define ASSET_SUBSYSTEM before including it to tag that file's loads (otherwise the current game state's subsystem is used)
+
+#pragma once
+
+#include "../Include/raylib.h"
+#include "Game_State.h"
+#include <stdint.h>
+
+// The README promises the game never goes over this
+#define ASSET_MEMORY_BUDGET (100ull * 1024 * 1024)
+
+enum AssetKinds
+{
+    ASSET_TEXTURE, ASSET_RENDER_TEXTURE, ASSET_FONT, ASSET_SOUND, ASSET_MUSIC
+};
+
+#define NUMBER_OF_ASSET_KINDS (ASSET_MUSIC + 1)
+
+// site is the function doing the load (for the load telemetry, see Asset_Telemetry.h)
+
+extern Texture2D TrackedLoadTexture(const char * fileName, const char * subsystem, const char * site);
+extern Texture2D TrackedLoadTextureFromImage(Image image, const char * subsystem, const char * site);
+extern RenderTexture2D TrackedLoadRenderTexture(int width, int height, const char * subsystem, const char * site);
+extern Font TrackedLoadFont(const char * fileName, const char * subsystem, const char * site);
+extern Sound TrackedLoadSound(const char * fileName, const char * subsystem, const char * site);
+extern Music TrackedLoadMusicStream(const char * fileName, const char * subsystem, const char * site);
+
+extern void TrackedUnloadTexture(Texture2D texture);
+extern void TrackedUnloadRenderTexture(RenderTexture2D target);
+extern void TrackedUnloadFont(Font font);
+extern void TrackedUnloadSound(Sound sound);
+extern void TrackedUnloadMusicStream(Music music);
+
+// Tells the tracker which game state assets are being loaded for (called by SwapGameState before initializing the new state)
+extern void SetAssetGameState(enum GameStateTypes state);
+
+// Gets the estimated amount of bytes used by every currently loaded texture (textures, render textures and font atlases)
+extern uint64_t GetTrackedTextureMemory(void);
+
+// Gets the amount of textures currently loaded (textures, render textures and font atlases)
+extern uint32_t GetTrackedTextureCount(void);
+
+// Gets the estimated amount of bytes used by every currently loaded sound and music stream
+extern uint64_t GetTrackedAudioMemory(void);
+
+// Gets the highest amount of tracked bytes (textures + audio) seen while in a game state
+extern uint64_t GetAssetHighWaterMark(enum GameStateTypes state);
+
+// Prints live totals per subsystem, high-water marks per game state, every live asset and files loaded more than once
+extern void PrintAssetReport(void);
+
+#ifndef ASSET_TRACKER_IMPLEMENTATION
+
+#ifndef ASSET_SUBSYSTEM
+#define ASSET_SUBSYSTEM NULL
+#endif
+
+// Variadic so compound literal arguments (which have unprotected commas) pass through
+
+#define LoadTexture(...) TrackedLoadTexture(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+#define LoadTextureFromImage(...) TrackedLoadTextureFromImage(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+#define LoadRenderTexture(...) TrackedLoadRenderTexture(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+#define LoadFont(...) TrackedLoadFont(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+#define LoadSound(...) TrackedLoadSound(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+#define LoadMusicStream(...) TrackedLoadMusicStream(__VA_ARGS__, ASSET_SUBSYSTEM, __func__)
+
+#define UnloadTexture(...) TrackedUnloadTexture(__VA_ARGS__)
+#define UnloadRenderTexture(...) TrackedUnloadRenderTexture(__VA_ARGS__)
+#define UnloadFont(...) TrackedUnloadFont(__VA_ARGS__)
+#define UnloadSound(...) TrackedUnloadSound(__VA_ARGS__)
+#define UnloadMusicStream(...) TrackedUnloadMusicStream(__VA_ARGS__)
+
+#endif
@@ -22,6 +22,7 @@
 
 
 #include "Background.h"
+#include "Render_Stats.h"
 #include <stdint.h>
 
 void RenderBackground(Texture2D background)
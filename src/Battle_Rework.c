@@ -28,6 +28,10 @@
 #include "UI.h"
 #include "Battle_Rework.h"
 #include "World.h"
+#include "Profiler.h"
+#define ASSET_SUBSYSTEM "Battle"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
 #include <malloc.h>
 #include <math.h>
 #include "../Include/raymath.h"
@@ -165,27 +169,37 @@ void Init_original_positions(void)
 
 uint32_t attack_cooldown[MAX_PARTY_MEMBERS * 2] = {0};
 
-static clock_t start_time = 0;
-void InitBattle(void)
+// Background of the zone Freddy was last in
+static const char * BattleBackgroundPath = "Assets/Battle/Background/Fazbear_Hills.png";
+
+// Zone listener, picks the battle background for the zone Freddy entered (outside every zone it stays the same)
+void UpdateBattleZone(uint8_t exited, uint8_t entered)
 {
-    SetWindowTitle("FNaF World: C Edition - Battle");
-    SetTraceLogLevel(LOG_NONE);
-    particle_test = CreateParticleIndexA_V2("Assets/Particles/bird.png", 30, 10, (Vector2) {50, 50}, 1.5);;
-    switch ((enum WORLDZONES) (GetZone() + 1))
+    (void) exited;
+    switch ((enum WORLDZONES) (entered + 1))
     {
         case FAZBEARHILLS:
-            BattleBackground = LoadTexture("Assets/Battle/Background/Fazbear_Hills.png");
+            BattleBackgroundPath = "Assets/Battle/Background/Fazbear_Hills.png";
             break;
         case CHOPPYSWOODS:
-            BattleBackground = LoadTexture("Assets/Battle/Background/Choppys_Woods.png");;
+            BattleBackgroundPath = "Assets/Battle/Background/Choppys_Woods.png";
             break;
         case DUSTINGFIELDS:
-            BattleBackground = LoadTexture("Assets/Battle/Background/Dusting_Fields.png");
+            BattleBackgroundPath = "Assets/Battle/Background/Dusting_Fields.png";
             break;
         case MYSTERIOUSMINES:
-            BattleBackground = LoadTexture("Assets/Battle/Background/Mines.png");;
+            BattleBackgroundPath = "Assets/Battle/Background/Mines.png";
             break;
     }
+}
+
+static clock_t start_time = 0;
+void InitBattle(void)
+{
+    SetWindowTitle("FNaF World: C Edition - Battle");
+    SetTraceLogLevel(LOG_NONE);
+    particle_test = CreateParticleIndexA_V2("Assets/Particles/bird.png", 30, 10, (Vector2) {50, 50}, 1.5);;
+    BattleBackground = LoadTexture(BattleBackgroundPath);
 
     SetTextureFilter(BattleBackground, TEXTURE_FILTER_BILINEAR);
 
@@ -476,6 +490,8 @@ void DisplayHUD(void)
 
 void PutBattle(void)
 {
+    PROFILE_SCOPE("PutBattle");
+
     UpdateMusicStream(theme);
 
     RenderBattle();
@@ -73,6 +73,9 @@ typedef struct _BattleParty
     _BattleEntity member[MAX_PARTY_MEMBERS];
 } _BattleParty;
 
+// Zone listener, picks the battle background for the zone Freddy entered (subscribe with SubscribeZoneChange)
+extern void UpdateBattleZone(uint8_t exited, uint8_t entered);
+
 extern void InitBattle(void);
 extern void DealDamage(uint32_t amount, uint8_t target);
 extern void UninitBattle(void);
@@ -0,0 +1,179 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Debug_Overlay.h"
+#include "../Include/raylib.h"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
+#include "Game_State.h"
+#include "Particle.h"
+#include "World.h"
+#include "input.h"
+#include "Alloc_Tracker.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OVERLAY_X 10
+#define OVERLAY_Y 10
+#define OVERLAY_FONT_SIZE 20
+#define OVERLAY_LINE_HEIGHT 22
+#define OVERLAY_GRAPH_HEIGHT 80
+#define OVERLAY_TARGET_FRAME_TIME (1 / 240.f)
+
+static _Bool DebugOverlayShown = 0;
+
+static float FrameTimes[DEBUG_OVERLAY_FRAMES] = {0}; // Seconds, ring buffer
+static uint16_t FrameTimeHead = 0;
+static uint16_t AmountOfFrameTimes = 0;
+
+static int CompareFloats(const void * a, const void * b)
+{
+    float x = *(const float *) a;
+    float y = *(const float *) b;
+    return (x > y) - (x < y);
+}
+
+// Shows / hides the performance overlay (only the FPS counter is drawn when hidden)
+void ToggleDebugOverlay(void)
+{
+    DebugOverlayShown = !DebugOverlayShown;
+}
+
+static void RenderOverlayLine(const char * text, uint8_t line, Color color)
+{
+    DrawText(text, OVERLAY_X + 8, OVERLAY_Y + OVERLAY_GRAPH_HEIGHT + 12 + line * OVERLAY_LINE_HEIGHT, OVERLAY_FONT_SIZE, color);
+}
+
+// Draws the last DEBUG_OVERLAY_FRAMES frame times as bars (oldest on the left), the lines mark the 240 FPS budget and 2x it
+static void RenderFrameTimeGraph(void)
+{
+    const float graph_max = OVERLAY_TARGET_FRAME_TIME * 4;
+    const int bottom = OVERLAY_Y + 8 + OVERLAY_GRAPH_HEIGHT;
+
+    for (uint16_t i = 0; i < AmountOfFrameTimes; i++)
+    {
+        float frame_time = FrameTimes[(FrameTimeHead + DEBUG_OVERLAY_FRAMES - AmountOfFrameTimes + i) % DEBUG_OVERLAY_FRAMES];
+        int height = frame_time / graph_max * OVERLAY_GRAPH_HEIGHT;
+        if (height > OVERLAY_GRAPH_HEIGHT) height = OVERLAY_GRAPH_HEIGHT;
+
+        Color color = frame_time > OVERLAY_TARGET_FRAME_TIME * 2 ? RED : frame_time > OVERLAY_TARGET_FRAME_TIME * 1.25f ? YELLOW : GREEN;
+        DrawRectangle(OVERLAY_X + 8 + (DEBUG_OVERLAY_FRAMES - AmountOfFrameTimes) + i, bottom - height, 1, height, color);
+    }
+
+    DrawRectangle(OVERLAY_X + 8, bottom - OVERLAY_GRAPH_HEIGHT / 4, DEBUG_OVERLAY_FRAMES, 1, (Color) {255, 255, 255, 120});
+    DrawRectangle(OVERLAY_X + 8, bottom - OVERLAY_GRAPH_HEIGHT / 2, DEBUG_OVERLAY_FRAMES, 1, (Color) {255, 80, 80, 120});
+}
+
+static void RenderDebugOverlay(void)
+{
+    static float sorted[DEBUG_OVERLAY_FRAMES];
+    char text[128];
+
+    // Frame time stats
+
+    float total = 0;
+    for (uint16_t i = 0; i < AmountOfFrameTimes; i++) sorted[i] = FrameTimes[i], total += FrameTimes[i];
+    qsort(sorted, AmountOfFrameTimes, sizeof(float), CompareFloats);
+
+    float min = AmountOfFrameTimes ? sorted[0] : 0;
+    float avg = AmountOfFrameTimes ? total / AmountOfFrameTimes : 0;
+    float p99 = AmountOfFrameTimes ? sorted[(uint16_t) ((AmountOfFrameTimes - 1) * 0.99f)] : 0;
+
+    uint8_t lines = 10;
+
+    #ifdef ALLOC_TRACKER
+
+    lines++;
+
+    #endif
+
+    DrawRectangle(OVERLAY_X, OVERLAY_Y, DEBUG_OVERLAY_FRAMES + 16, OVERLAY_GRAPH_HEIGHT + 20 + lines * OVERLAY_LINE_HEIGHT, (Color) {0, 0, 0, 180});
+
+    RenderFrameTimeGraph();
+
+    uint8_t line = 0;
+
+    snprintf(text, sizeof(text), "%d FPS  %s", GetFPS(), GetGameStateName(GetGameState()));
+    RenderOverlayLine(text, line++, WHITE);
+
+    snprintf(text, sizeof(text), "min %.2f  avg %.2f  p99 %.2f ms", min * 1000, avg * 1000, p99 * 1000);
+    RenderOverlayLine(text, line++, p99 > OVERLAY_TARGET_FRAME_TIME * 2 ? RED : WHITE);
+
+    snprintf(text, sizeof(text), "Particles: %u / %u", GetParticleCount(), MAX_PARTICLES);
+    RenderOverlayLine(text, line++, WHITE);
+
+    if (GetGameState() == World)
+    {
+        snprintf(text, sizeof(text), "Entities visible: %u", GetVisibleWorldEntityCount());
+        RenderOverlayLine(text, line++, WHITE);
+
+        uint8_t zone = GetZone();
+        if (zone == UNKNOWN_ZONE) snprintf(text, sizeof(text), "Zone: Unknown");
+        else snprintf(text, sizeof(text), "Zone: %u", zone + 1);
+        RenderOverlayLine(text, line++, WHITE);
+
+        Vector2 virtual_screen = GetWorldVirtualScreenSize();
+        snprintf(text, sizeof(text), "World RT: %dx%d", (int) virtual_screen.x, (int) virtual_screen.y);
+        RenderOverlayLine(text, line++, WHITE);
+    }
+
+    snprintf(text, sizeof(text), "Textures: %u (~%.1f MB)  Audio: ~%.1f MB", GetTrackedTextureCount(), 
+             GetTrackedTextureMemory() / (1024. * 1024.), GetTrackedAudioMemory() / (1024. * 1024.));
+    RenderOverlayLine(text, line++, WHITE);
+
+    uint64_t peak = GetAssetHighWaterMark(GetGameState());
+    snprintf(text, sizeof(text), "Asset peak this state: ~%.1f MB", peak / (1024. * 1024.));
+    RenderOverlayLine(text, line++, peak > ASSET_MEMORY_BUDGET ? RED : WHITE);
+
+    // Counts of the last full frame (this one isn't done yet)
+
+    RenderStats stats = GetLastFrameRenderStats();
+    snprintf(text, sizeof(text), "Draws: %u  Flushes: %u  Binds: %u", stats.draw_calls, stats.batch_flushes, stats.texture_binds);
+    RenderOverlayLine(text, line++, WHITE);
+
+    snprintf(text, sizeof(text), "Quads: %u  Blend: %u  RT: %u", stats.quads, stats.blend_switches, stats.target_switches);
+    RenderOverlayLine(text, line++, WHITE);
+
+    #ifdef ALLOC_TRACKER
+
+    snprintf(text, sizeof(text), "Allocs: %u last frame, %llu steady-state", GetLastFrameAllocations(), (unsigned long long) GetSteadyStateAllocations());
+    RenderOverlayLine(text, line++, GetSteadyStateAllocations() ? RED : WHITE);
+
+    #endif
+}
+
+// Records this frame's frame time and renders the overlay, toggled with DEBUG_OVERLAY_KEY
+void PutDebugOverlay(void)
+{
+    // Real frame time (not GetInputFrameTime) so replays still show how long frames actually take
+
+    FrameTimes[FrameTimeHead] = GetFrameTime();
+    FrameTimeHead = (FrameTimeHead + 1) % DEBUG_OVERLAY_FRAMES;
+    if (AmountOfFrameTimes < DEBUG_OVERLAY_FRAMES) AmountOfFrameTimes++;
+
+    if (IsInputKeyPressed(DEBUG_OVERLAY_KEY)) ToggleDebugOverlay();
+
+    if (DebugOverlayShown) RenderDebugOverlay();
+    else DrawFPS(10, 10);
+}
@@ -0,0 +1,36 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// The amount of frames the frame time graph and stats cover
+#define DEBUG_OVERLAY_FRAMES 240
+
+#define DEBUG_OVERLAY_KEY KEY_F3
+
+// Shows / hides the performance overlay (only the FPS counter is drawn when hidden)
+extern void ToggleDebugOverlay(void);
+
+// Records this frame's frame time and renders the overlay, toggled with DEBUG_OVERLAY_KEY
+extern void PutDebugOverlay(void);
@@ -36,6 +36,10 @@
 #include "Entity_Info.h"
 #include "Game_State.h"
 #include "rayclock.h"
+#define ASSET_SUBSYSTEM "Dialogue"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
+#include "Alloc_Tracker.h"
 
 clock_t DialogueClock = 0;
 #define MAX_LINES 255
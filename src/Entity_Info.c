@@ -28,6 +28,8 @@
 #include "Battle_Rework.h"
 #include "Save.h"
 #include "UI.h"
+#define ASSET_SUBSYSTEM "Battle"
+#include "Asset_Tracker.h"
 #include <stdint.h>
 #include <string.h>
 
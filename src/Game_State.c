@@ -29,11 +29,24 @@
 #include "Particle.h"
 #include "Dialogue.h"
 #include "rayclock.h"
+#include "Render_Stats.h"
+#include "Asset_Tracker.h"
 
 enum GameStateTypes GameState = 1000;
 
 _GameStateScene CurrentSceneSnapshot = {0};
 
+static const char * GameStateNames[NUMBER_OF_GAME_STATES] = 
+{
+    "Disclamer", "SpookyWarning", "Title", "Save", "Party", "World", "Chips", "Bytes", "Battle", "Dialogue"
+};
+
+// Gets the name of a game state ("Unknown" for invalid ones)
+const char * GetGameStateName(enum GameStateTypes state)
+{
+    return (unsigned) state < NUMBER_OF_GAME_STATES ? GameStateNames[state] : "Unknown";
+}
+
 void SwapGameState(enum GameStateTypes state)
 {
     switch (GameState)
@@ -55,6 +68,8 @@ void SwapGameState(enum GameStateTypes state)
     }
 
     FlushParticles();
+
+    SetAssetGameState(state);
     
     switch (state) 
     {
@@ -80,7 +95,7 @@ void SwapGameState(enum GameStateTypes state)
 
 void RunGameScene(_GameStateScene * scene)
 {
-    if (scene -> SceneClock) *scene -> SceneClock += GetFrameTime() * RAYCLOCKS_PER_SEC * scene -> TimeScale;
+    if (scene -> SceneClock) *scene -> SceneClock += GetInputFrameTime() * RAYCLOCKS_PER_SEC * scene -> TimeScale;
     if (scene -> UpdateScene) scene -> UpdateScene();
     if (scene -> RenderScene) scene -> RenderScene();
 
@@ -98,14 +113,14 @@ clock_t end_time = 0;
 void SwapGameState_Animated(enum TransitionAnimationTypes type, enum GameStateTypes state, float duration)
 {
     animation = type;
-    start_time = clock();
+    start_time = Rayclock();
     end_time = start_time + CLOCKS_PER_SEC * duration;
     target_gamestate = state;
 }
 
 void UpdateTransitionAnimation(void)
 {
-    if (clock() >= end_time) 
+    if (Rayclock() >= end_time) 
     {
         SwapGameState(target_gamestate);
         start_time = 0;
@@ -116,7 +131,7 @@ void UpdateTransitionAnimation(void)
 
 float GetAnimationPercentage(void)
 {
-    return (float) (clock() - start_time) / (end_time - start_time);
+    return (float) (Rayclock() - start_time) / (end_time - start_time);
 }
 
 _Bool IsGameStateSwitching(void)
@@ -58,9 +58,14 @@ enum GameStateTypes
     Disclamer, SpookyWarning, Title, Save, Party, World, Chips, Bytes, Battle, Dialogue
 };
 
+#define NUMBER_OF_GAME_STATES (Dialogue + 1)
+
 void SwapGameState(enum GameStateTypes state);
 enum GameStateTypes GetGameState(void);
 
+// Gets the name of a game state ("Unknown" for invalid ones)
+const char * GetGameStateName(enum GameStateTypes state);
+
 enum TransitionAnimationTypes
 {
     NOCURRENT, FADE
@@ -0,0 +1,204 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// clock_gettime and CLOCK_MONOTONIC are POSIX, a plain -std=c17 build doesn't declare them otherwise
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "Hitch_Recorder.h"
+#include "Game_State.h"
+#include "Particle.h"
+#include "Profiler.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+
+    // windows.h clashes with Raylib (Rectangle, CloseWindow, ...) so only the performance counter is declared
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(long long * count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long * frequency);
+
+#endif
+
+#define HITCH_DETAIL_LENGTH 96
+
+// Profiler scopes shorter than this are left out of the log
+#define HITCH_MIN_SCOPE_DURATION 100000 // 0.1 ms
+#define HITCH_MAX_SCOPE_LINES 48
+
+typedef struct HitchEvent
+{
+    enum HitchEventTypes type;
+    uint64_t duration; // Nanoseconds
+    char detail[HITCH_DETAIL_LENGTH];
+} HitchEvent;
+
+static const char * HitchEventNames[] = {"Asset load", "Music open", "Save"};
+
+static double HitchBudget = HITCH_DEFAULT_BUDGET;
+static char HitchLogPath[256] = HITCH_LOG_PATH;
+
+static HitchEvent FrameEvents[MAX_HITCH_EVENTS];
+static uint16_t AmountOfFrameEvents = 0;
+static uint32_t DroppedFrameEvents = 0;
+
+static uint64_t FrameStart = 0;
+static uint64_t FrameNumber = 0;
+static uint16_t FrameStartParticles = 0;
+static enum GameStateTypes FrameStartState = 0;
+static uint32_t HitchCount = 0;
+
+// Sets how long a frame can take (in seconds) before it counts as a hitch
+void SetHitchBudget(double seconds)
+{
+    if (seconds > 0) HitchBudget = seconds;
+}
+
+// Sets the file hitches are logged to (DEFAULT: HITCH_LOG_PATH)
+void SetHitchLogPath(const char * path)
+{
+    snprintf(HitchLogPath, sizeof(HitchLogPath), "%s", path);
+}
+
+// Gets a timestamp in nanoseconds to time events with (monotonic and thread safe, the profiler times its scopes with it too)
+uint64_t GetHitchTimestamp(void)
+{
+    #ifdef _WIN32
+
+    long long count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t) (count / frequency) * 1000000000ull + (uint64_t) (count % frequency) * 1000000000ull / frequency;
+
+    #else
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + now.tv_nsec;
+
+    #endif
+}
+
+// Remembers something slow that happened this frame (detail is copied)
+void RecordHitchEvent(enum HitchEventTypes type, const char * detail, uint64_t duration_ns)
+{
+    if (AmountOfFrameEvents >= MAX_HITCH_EVENTS)
+    {
+        DroppedFrameEvents++;
+        return;
+    }
+
+    HitchEvent * event = FrameEvents + AmountOfFrameEvents++;
+    event -> type = type;
+    event -> duration = duration_ns;
+    snprintf(event -> detail, HITCH_DETAIL_LENGTH, "%s", detail ? detail : "");
+}
+
+// Starts timing a frame, call at the very start of every frame
+void BeginHitchFrame(void)
+{
+    AmountOfFrameEvents = 0;
+    DroppedFrameEvents = 0;
+    FrameStartParticles = GetParticleCount();
+    FrameStartState = GetGameState();
+    FrameStart = GetHitchTimestamp();
+}
+
+// Moves the log out of the way once it gets too big so it never grows without limit
+static void RotateHitchLog(void)
+{
+    FILE * file = fopen(HitchLogPath, "rb");
+    if (!file) return;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    if (size < HITCH_LOG_MAX_BYTES) return;
+
+    char old_path[sizeof(HitchLogPath) + 2];
+    snprintf(old_path, sizeof(old_path), "%s.1", HitchLogPath);
+    remove(old_path);
+    if (rename(HitchLogPath, old_path)) remove(HitchLogPath);
+}
+
+static void WriteHitch(uint64_t frame_time)
+{
+    RotateHitchLog();
+
+    FILE * file = fopen(HitchLogPath, "a");
+    if (!file)
+    {
+        printf("HITCH_RECORDER: Couldn't open \"%s\"!\n", HitchLogPath);
+        return;
+    }
+
+    enum GameStateTypes state = GetGameState();
+
+    fprintf(file, "Frame %llu: %.3f ms (budget %.3f ms) in %s", (unsigned long long) FrameNumber, frame_time / 1000000.,
+            HitchBudget * 1000, GetGameStateName(FrameStartState));
+    if (state != FrameStartState) fprintf(file, " -> %s", GetGameStateName(state));
+    fprintf(file, "\n  Particles: %u -> %u\n", FrameStartParticles, GetParticleCount());
+
+    for (uint16_t i = 0; i < AmountOfFrameEvents; i++)
+    {
+        fprintf(file, "  %-10s %9.3f ms  %s\n", HitchEventNames[FrameEvents[i].type], FrameEvents[i].duration / 1000000.,
+                FrameEvents[i].detail);
+    }
+    if (DroppedFrameEvents) fprintf(file, "  ... and %u more events\n", DroppedFrameEvents);
+
+    #ifdef PROFILER
+
+    fprintf(file, "  Scopes:\n");
+    WriteProfileScopesSince(file, FrameStart, HITCH_MIN_SCOPE_DURATION, HITCH_MAX_SCOPE_LINES);
+
+    #endif
+
+    fprintf(file, "\n");
+    fclose(file);
+}
+
+// Stops timing the frame and logs it if it went over budget, returns 1 if it did
+_Bool EndHitchFrame(void)
+{
+    uint64_t frame_time = GetHitchTimestamp() - FrameStart;
+    _Bool hitch = FrameStart && frame_time > HitchBudget * 1e9;
+
+    if (hitch)
+    {
+        WriteHitch(frame_time);
+        HitchCount++;
+    }
+
+    FrameNumber++;
+    AmountOfFrameEvents = 0;
+    DroppedFrameEvents = 0;
+    return hitch;
+}
+
+// Gets the amount of hitches logged so far
+uint32_t GetHitchCount(void)
+{
+    return HitchCount;
+}
@@ -0,0 +1,65 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Hitch recorder, when a frame goes over budget it writes what happened during that frame (asset loads, saves,
+// music stream opens, particle counts and, when built with -DPROFILER, the profiler scopes) to a rolling log file
+
+#pragma once
+
+#include <stdint.h>
+
+// DEFAULT: 2x the 240 FPS frame time
+#define HITCH_DEFAULT_BUDGET (2 / 240.)
+
+#define HITCH_LOG_PATH "hitches.log"
+
+// Once the log gets bigger than this it's moved to HITCH_LOG_PATH ".1" (replacing the old one) and a new one is started
+#define HITCH_LOG_MAX_BYTES (1024 * 1024)
+
+// Events remembered per frame (the rest are only counted)
+#define MAX_HITCH_EVENTS 64
+
+enum HitchEventTypes
+{
+    HITCH_ASSET_LOAD, HITCH_MUSIC_OPEN, HITCH_SAVE
+};
+
+// Sets how long a frame can take (in seconds) before it counts as a hitch
+extern void SetHitchBudget(double seconds);
+
+// Sets the file hitches are logged to (DEFAULT: HITCH_LOG_PATH)
+extern void SetHitchLogPath(const char * path);
+
+// Gets a timestamp in nanoseconds to time events with (monotonic and thread safe, the profiler times its scopes with it too)
+extern uint64_t GetHitchTimestamp(void);
+
+// Remembers something slow that happened this frame (detail is copied)
+extern void RecordHitchEvent(enum HitchEventTypes type, const char * detail, uint64_t duration_ns);
+
+// Starts timing a frame, call at the very start of every frame
+extern void BeginHitchFrame(void);
+
+// Stops timing the frame and logs it if it went over budget, returns 1 if it did
+extern _Bool EndHitchFrame(void);
+
+// Gets the amount of hitches logged so far
+extern uint32_t GetHitchCount(void);
@@ -23,11 +23,15 @@
 #include "Particle.h"
 #include "Animation.h"
 #include "UI.h"
+#include "Profiler.h"
+#define ASSET_SUBSYSTEM "Particle"
+#include "Asset_Tracker.h"
 #include <stdint.h>
 #include <memory.h>
 #include <math.h>
 #include <stdio.h>
 #include <time.h>
+#include "rayclock.h"
 
 // I should probably used linked-lists to improve the performence of allocations
 // but I'm too lazy :D
@@ -118,7 +122,7 @@ void CreateParticle(uint8_t textureID, float x, float y, float velocityX, float
     AllParticles[id].y = y;
     AllParticles[id].velocityX = velocityX;
     AllParticles[id].velocityY = velocityY;
-    AllParticles[id].startTime = clock();
+    AllParticles[id].startTime = Rayclock();
     AllParticles[id].angularFrequency = 0;
     AllParticles[id].additionalUpdater = NULL;
     AllParticles[id].terminationUpdate = NULL;
@@ -135,7 +139,7 @@ void CreateParticleEx(uint8_t textureID, float x, float y, float velocityX, floa
     AllParticles[id].y = y;
     AllParticles[id].velocityX = velocityX;
     AllParticles[id].velocityY = velocityY;
-    AllParticles[id].startTime = clock();
+    AllParticles[id].startTime = Rayclock();
     AllParticles[id].angularFrequency = angularFrequency;
     AllParticles[id].additionalUpdater = additionalUpdater;
     AllParticles[id].terminationUpdate = NULL;
@@ -152,7 +156,7 @@ void CreateParticlePro(uint8_t textureID, float x, float y, float velocityX, flo
     AllParticles[id].y = y;
     AllParticles[id].velocityX = velocityX;
     AllParticles[id].velocityY = velocityY;
-    AllParticles[id].startTime = clock();
+    AllParticles[id].startTime = Rayclock();
     AllParticles[id].angularFrequency = angularFrequency;
     AllParticles[id].additionalUpdater = additionalUpdater;
     AllParticles[id].terminationUpdate = terminationUpdate;
@@ -210,12 +214,12 @@ void FlushParticles(void)
 // Updates a UIParticle position with its velocity
 void UpdateUIParticle(uint16_t id) 
 {
-    AllParticles[id].x += AllParticles[id].velocityX * GetFrameTime();
-    AllParticles[id].y += AllParticles[id].velocityY * GetFrameTime();
+    AllParticles[id].x += AllParticles[id].velocityX * GetInputFrameTime();
+    AllParticles[id].y += AllParticles[id].velocityY * GetInputFrameTime();
 
     Vector2 size = (Vector2) {0, 0};
 
-    switch (ParticlesIndex[id].visual.type) 
+    switch (ParticlesIndex[AllParticles[id].textureID].visual.type) 
     {
         case UIanimation:
         {
@@ -258,7 +262,7 @@ void RenderUIParticle(uint16_t id, register float screenScale)
 {
     uint8_t indexID = AllParticles[id].textureID;
 
-    float rotation = fmodf((float) (clock() - AllParticles[id].startTime) / CLOCKS_PER_SEC * AllParticles[id].angularFrequency, 360.);
+    float rotation = fmodf((float) (Rayclock() - AllParticles[id].startTime) / CLOCKS_PER_SEC * AllParticles[id].angularFrequency, 360.);
     if (rotation < 0) rotation = 360 - absf(rotation);
     
     switch (ParticlesIndex[indexID].visual.type) 
@@ -327,6 +331,15 @@ void UpdateUIParticles(void)
 
 // Updates and Renders all particles on screen
 void PutUIParticles(void) {
+    PROFILE_SCOPE("PutUIParticles");
     UpdateUIParticles();
     RenderUIParticles();
-}
\ No newline at end of file
+}
+
+// Gets the amount of particles currently alive
+uint16_t GetParticleCount(void)
+{
+    uint16_t count = 0;
+    for (uint16_t id = 0; id < MAX_PARTICLES; id++) count += AllParticles[id].startTime != 0;
+    return count;
+}
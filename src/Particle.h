@@ -89,4 +89,7 @@ void RenderUIParticles(void);
 void UpdateUIParticles(void);
 
 // Updates and Renders all particles on screen
-void PutUIParticles(void);
\ No newline at end of file
+void PutUIParticles(void);
+
+// Gets the amount of particles currently alive
+uint16_t GetParticleCount(void);
\ No newline at end of file
@@ -24,10 +24,11 @@
 #include "Particle.h"
 #include <stdio.h>
 #include <time.h>
+#include "rayclock.h"
 
 void Updater_DeleteAfterQuarterSecond(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > CLOCKS_PER_SEC / 4) 
+    if (Rayclock() - particle -> startTime > CLOCKS_PER_SEC / 4) 
     {
         particle -> startTime = 0;
     }
@@ -35,7 +36,7 @@ void Updater_DeleteAfterQuarterSecond(UIParticle * particle)
 
 void Updater_DeleteAfterHalfSecond(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > CLOCKS_PER_SEC / 2) 
+    if (Rayclock() - particle -> startTime > CLOCKS_PER_SEC / 2) 
     {
         particle -> startTime = 0;
     }
@@ -43,7 +44,7 @@ void Updater_DeleteAfterHalfSecond(UIParticle * particle)
 
 void Updater_DeleteAfterSecond(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > 1 * CLOCKS_PER_SEC) 
+    if (Rayclock() - particle -> startTime > 1 * CLOCKS_PER_SEC) 
     {
         particle -> startTime = 0;
     }
@@ -51,7 +52,7 @@ void Updater_DeleteAfterSecond(UIParticle * particle)
 
 void Updater_DeleteAfter2Seconds(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > 2 * CLOCKS_PER_SEC) 
+    if (Rayclock() - particle -> startTime > 2 * CLOCKS_PER_SEC) 
     {
         particle -> startTime = 0;
     }
@@ -59,7 +60,7 @@ void Updater_DeleteAfter2Seconds(UIParticle * particle)
 
 void Updater_DeleteAfter3Seconds(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > 3 * CLOCKS_PER_SEC) 
+    if (Rayclock() - particle -> startTime > 3 * CLOCKS_PER_SEC) 
     {
         particle -> startTime = 0;
     }
@@ -67,7 +68,7 @@ void Updater_DeleteAfter3Seconds(UIParticle * particle)
 
 void Updater_DeleteAfter5Seconds(UIParticle * particle)
 {
-    if (clock() - particle -> startTime > 5 * CLOCKS_PER_SEC) 
+    if (Rayclock() - particle -> startTime > 5 * CLOCKS_PER_SEC) 
     {
         particle -> startTime = 0;
     }
@@ -75,20 +76,20 @@ void Updater_DeleteAfter5Seconds(UIParticle * particle)
 
 void Updater_WeakGravity(UIParticle * particle)
 {
-    particle->velocityX  -= particle->velocityX / 0.1 * GetFrameTime();
-    particle->velocityY  += 0.981 * GetFrameTime();
+    particle->velocityX  -= particle->velocityX / 0.1 * GetInputFrameTime();
+    particle->velocityY  += 0.981 * GetInputFrameTime();
 }
 
 void Updater_MediumGravity(UIParticle * particle)
 {
-    particle->velocityX  -= particle->velocityX / 0.1 * GetFrameTime();
-    particle->velocityY  += 9.81 * GetFrameTime();
+    particle->velocityX  -= particle->velocityX / 0.1 * GetInputFrameTime();
+    particle->velocityY  += 9.81 * GetInputFrameTime();
 }
 
 void Updater_StrongGravity(UIParticle * particle)
 {
-    particle->velocityX  -= particle->velocityX / 0.1 * GetFrameTime();
-    particle->velocityY  += 9.81 * GetFrameTime() / 2;
+    particle->velocityX  -= particle->velocityX / 0.1 * GetInputFrameTime();
+    particle->velocityY  += 9.81 * GetInputFrameTime() / 2;
 }
 
 void Updater_DeleteAfterAnimation(UIParticle * particle)
@@ -97,5 +98,5 @@ void Updater_DeleteAfterAnimation(UIParticle * particle)
 
     clock_t end_time = animation.Amount * (1. / animation.FPS) + particle -> startTime;
 
-    if (clock() >= end_time) particle -> startTime = 0;
+    if (Rayclock() >= end_time) particle -> startTime = 0;
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Profiler.h"
+
+#ifdef PROFILER
+
+#include "Hitch_Recorder.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct ProfileEvent
+{
+    const char * name;
+    uint64_t start; // Nanoseconds
+    uint64_t duration; // Nanoseconds
+} ProfileEvent;
+
+// Only the owning thread writes to its ring buffer, so pushing an event is just a store and a release of head
+typedef struct ProfilerThread
+{
+    ProfileEvent * events;
+    _Atomic uint64_t head; // Total events ever pushed
+    uint32_t id;
+    struct ProfilerThread * next;
+} ProfilerThread;
+
+static _Atomic(ProfilerThread *) ProfilerThreads = NULL;
+static _Atomic uint32_t AmountOfProfilerThreads = 0;
+static _Thread_local ProfilerThread * CurrentProfilerThread = NULL;
+
+// Creates this thread's ring buffer and pushes it onto the thread list (lock-free)
+static ProfilerThread * RegisterProfilerThread(void)
+{
+    ProfilerThread * thread = calloc(1, sizeof(ProfilerThread));
+    if (!thread) return NULL;
+
+    thread -> events = malloc(PROFILER_EVENTS_PER_THREAD * sizeof(ProfileEvent));
+    if (!thread -> events)
+    {
+        free(thread);
+        return NULL;
+    }
+    thread -> id = atomic_fetch_add(&AmountOfProfilerThreads, 1);
+
+    ProfilerThread * head = atomic_load(&ProfilerThreads);
+    do thread -> next = head;
+    while (!atomic_compare_exchange_weak(&ProfilerThreads, &head, thread));
+
+    return thread;
+}
+
+ProfileScope BeginProfileScope(const char * name)
+{
+    return (ProfileScope) {name, GetHitchTimestamp()};
+}
+
+void EndProfileScope(ProfileScope * scope)
+{
+    uint64_t end = GetHitchTimestamp();
+
+    if (!CurrentProfilerThread) CurrentProfilerThread = RegisterProfilerThread();
+    if (!CurrentProfilerThread) return;
+
+    uint64_t head = atomic_load_explicit(&CurrentProfilerThread -> head, memory_order_relaxed);
+    CurrentProfilerThread -> events[head % PROFILER_EVENTS_PER_THREAD] = (ProfileEvent) {scope -> name, scope -> start, end - scope -> start};
+    atomic_store_explicit(&CurrentProfilerThread -> head, head + 1, memory_order_release);
+}
+
+_Bool ExportProfilerTrace(const char * path)
+{
+    FILE * file = fopen(path, "w");
+    if (!file)
+    {
+        printf("PROFILER: Couldn't create \"%s\"!\n", path);
+        return 0;
+    }
+
+    // Timestamps are written relative to the oldest event so they stay small
+
+    uint64_t origin = UINT64_MAX;
+    for (ProfilerThread * thread = atomic_load(&ProfilerThreads); thread; thread = thread -> next)
+    {
+        uint64_t head = atomic_load_explicit(&thread -> head, memory_order_acquire);
+        uint64_t first = head > PROFILER_EVENTS_PER_THREAD ? head - PROFILER_EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < head; i++)
+        {
+            if (thread -> events[i % PROFILER_EVENTS_PER_THREAD].start < origin) origin = thread -> events[i % PROFILER_EVENTS_PER_THREAD].start;
+        }
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    uint64_t written = 0;
+    for (ProfilerThread * thread = atomic_load(&ProfilerThreads); thread; thread = thread -> next)
+    {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                written++ ? ",\n" : "", thread -> id, thread -> id ? "Worker" : "Main", thread -> id);
+
+        uint64_t head = atomic_load_explicit(&thread -> head, memory_order_acquire);
+        uint64_t first = head > PROFILER_EVENTS_PER_THREAD ? head - PROFILER_EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < head; i++)
+        {
+            ProfileEvent * event = thread -> events + i % PROFILER_EVENTS_PER_THREAD;
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    event -> name, thread -> id, (event -> start - origin) / 1000., event -> duration / 1000.);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    printf("PROFILER: Wrote trace to \"%s\"\n", path);
+    return 1;
+}
+
+uint32_t WriteProfileScopesSince(FILE * file, uint64_t since, uint64_t min_duration, uint32_t max_lines)
+{
+    if (!CurrentProfilerThread) return 0;
+
+    // Scopes are pushed when they end, so walk back from the newest until one ended before (since)
+
+    uint64_t head = atomic_load_explicit(&CurrentProfilerThread -> head, memory_order_acquire);
+    uint64_t first = head > PROFILER_EVENTS_PER_THREAD ? head - PROFILER_EVENTS_PER_THREAD : 0;
+    uint64_t i = head;
+    while (i > first)
+    {
+        ProfileEvent * event = CurrentProfilerThread -> events + (i - 1) % PROFILER_EVENTS_PER_THREAD;
+        if (event -> start + event -> duration < since) break;
+        i--;
+    }
+
+    uint32_t written = 0;
+    for (; i < head && written < max_lines; i++)
+    {
+        ProfileEvent * event = CurrentProfilerThread -> events + i % PROFILER_EVENTS_PER_THREAD;
+        if (event -> duration < min_duration) continue;
+        fprintf(file, "    %9.3f ms  %s (at +%.3f ms)\n", event -> duration / 1000000., event -> name,
+                event -> start > since ? (event -> start - since) / 1000000. : 0.);
+        written++;
+    }
+    return written;
+}
+
+#endif
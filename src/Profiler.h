@@ -0,0 +1,73 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Scoped CPU profiler, only compiled in when building with -DPROFILER
+// Every PROFILE_SCOPE("name") times the rest of the block it's in and writes the result into a per-thread ring buffer,
+// the buffers are exported as Chrome trace_event JSON (open in chrome://tracing or ui.perfetto.dev)
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Events kept per thread (the oldest ones get overwritten once the ring buffer is full)
+#define PROFILER_EVENTS_PER_THREAD 65536
+
+#define PROFILER_TRACE_PATH "profile_trace.json"
+#define PROFILER_EXPORT_KEY KEY_F9
+
+#ifdef PROFILER
+
+typedef struct ProfileScope
+{
+    const char * name;
+    uint64_t start; // Nanoseconds
+} ProfileScope;
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// Times everything from here to the end of the current block
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__) __attribute__((cleanup(EndProfileScope))) = BeginProfileScope(name)
+
+// Writes every recorded event to (path) as Chrome trace_event JSON
+#define PROFILE_EXPORT(path) ExportProfilerTrace(path)
+
+// Starts a scope, use PROFILE_SCOPE instead
+extern ProfileScope BeginProfileScope(const char * name);
+
+// Ends a scope and pushes it into this thread's ring buffer, use PROFILE_SCOPE instead
+extern void EndProfileScope(ProfileScope * scope);
+
+// Writes every recorded event to (path) as Chrome trace_event JSON, returns 0 on failure
+extern _Bool ExportProfilerTrace(const char * path);
+
+// Writes the scopes this thread ended after (since) (nanoseconds, same clock as timespec_get) that took at least (min_duration)
+// to (file) as indented lines, at most (max_lines) of them, returns how many were written
+extern uint32_t WriteProfileScopesSince(FILE * file, uint64_t since, uint64_t min_duration, uint32_t max_lines);
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_EXPORT(path)
+
+#endif
@@ -34,6 +34,8 @@
 #include "Battle_Rework.h"
 #include "Entity_Info.h"
 #include "rayclock.h"
+#define ASSET_SUBSYSTEM "Battle"
+#include "Asset_Tracker.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -0,0 +1,242 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define RENDER_STATS_IMPLEMENTATION
+
+#include "Render_Stats.h"
+#include "../Include/rlgl.h"
+#include "Game_State.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define NUMBER_OF_COUNTED_STATES (NUMBER_OF_GAME_STATES + 1) // Last one is for unknown / invalid game states
+
+// The batch rlgl is currently filling
+
+static uint32_t BatchQuads = 0;
+static uint32_t BatchDraws = 0;
+static unsigned int BatchTexture = 0;
+static int CurrentBlendMode = BLEND_ALPHA;
+
+static RenderStats CurrentFrame = {0};
+static RenderStats LastFrame = {0};
+
+// 64 bit so long sessions don't overflow
+typedef struct RenderStatsTotals
+{
+    uint64_t quads, draw_calls, batch_flushes, texture_binds, blend_switches, target_switches;
+} RenderStatsTotals;
+
+static RenderStatsTotals StateTotals[NUMBER_OF_COUNTED_STATES] = {0};
+static uint64_t StateFrames[NUMBER_OF_COUNTED_STATES] = {0};
+
+// Same as rlDrawRenderBatch, every draw in the batch binds its texture and issues one glDrawElements
+static void FlushBatch(void)
+{
+    if (BatchQuads)
+    {
+        CurrentFrame.batch_flushes++;
+        CurrentFrame.draw_calls += BatchDraws;
+        CurrentFrame.texture_binds += BatchDraws;
+    }
+    BatchQuads = 0;
+    BatchDraws = 0;
+    BatchTexture = 0;
+}
+
+// Same as rlSetTexture + rlCheckRenderBatchLimit, a texture change starts a new draw in the batch
+static void PushQuads(unsigned int texture, uint32_t quads)
+{
+    if (!quads) return;
+
+    if (BatchQuads + quads > RL_DEFAULT_BATCH_BUFFER_ELEMENTS) FlushBatch();
+
+    if (!BatchDraws || texture != BatchTexture)
+    {
+        if (BatchDraws >= RL_DEFAULT_BATCH_DRAWCALLS) FlushBatch();
+        BatchDraws++;
+        BatchTexture = texture;
+    }
+
+    BatchQuads += quads;
+    CurrentFrame.quads += quads;
+}
+
+// Raylib skips spaces, tabs and newlines when drawing text
+static uint32_t CountGlyphs(const char * text)
+{
+    uint32_t glyphs = 0;
+    for (; *text; text++) glyphs += *text != ' ' && *text != '\t' && *text != '\n';
+    return glyphs;
+}
+
+// Shapes and the default font share the default font's texture
+static unsigned int GetDefaultTextureId(void)
+{
+    return GetFontDefault().texture.id;
+}
+
+void TrackedDrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    if (texture.id > 0) PushQuads(texture.id, 1);
+    DrawTexturePro(texture, source, dest, origin, rotation, tint);
+}
+
+void TrackedDrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint)
+{
+    if (texture.id > 0) PushQuads(texture.id, 1);
+    DrawTextureEx(texture, position, rotation, scale, tint);
+}
+
+void TrackedDrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    PushQuads(GetDefaultTextureId(), 1);
+    DrawRectangle(posX, posY, width, height, color);
+}
+
+void TrackedDrawRectangleRec(Rectangle rec, Color color)
+{
+    PushQuads(GetDefaultTextureId(), 1);
+    DrawRectangleRec(rec, color);
+}
+
+void TrackedDrawText(const char * text, int posX, int posY, int fontSize, Color color)
+{
+    PushQuads(GetDefaultTextureId(), CountGlyphs(text));
+    DrawText(text, posX, posY, fontSize, color);
+}
+
+void TrackedDrawTextPro(Font font, const char * text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint)
+{
+    PushQuads(font.texture.id ? font.texture.id : GetDefaultTextureId(), CountGlyphs(text));
+    DrawTextPro(font, text, position, origin, rotation, fontSize, spacing, tint);
+}
+
+void TrackedDrawFPS(int posX, int posY)
+{
+    // Same text DrawFPS draws
+    char text[16];
+    snprintf(text, sizeof(text), "%2i FPS", GetFPS());
+    PushQuads(GetDefaultTextureId(), CountGlyphs(text));
+    DrawFPS(posX, posY);
+}
+
+void TrackedBeginTextureMode(RenderTexture2D target)
+{
+    FlushBatch();
+    CurrentFrame.target_switches++;
+    BeginTextureMode(target);
+}
+
+void TrackedEndTextureMode(void)
+{
+    FlushBatch();
+    CurrentFrame.target_switches++;
+    EndTextureMode();
+}
+
+void TrackedBeginBlendMode(int mode)
+{
+    if (mode != CurrentBlendMode)
+    {
+        FlushBatch();
+        CurrentFrame.blend_switches++;
+        CurrentBlendMode = mode;
+    }
+    BeginBlendMode(mode);
+}
+
+void TrackedEndBlendMode(void)
+{
+    TrackedBeginBlendMode(BLEND_ALPHA);
+    EndBlendMode();
+}
+
+// rlTextureParameters binds the texture to change its parameters
+void TrackedSetTextureFilter(Texture2D texture, int filter)
+{
+    CurrentFrame.texture_binds++;
+    SetTextureFilter(texture, filter);
+}
+
+void TrackedSetTextureWrap(Texture2D texture, int wrap)
+{
+    CurrentFrame.texture_binds++;
+    SetTextureWrap(texture, wrap);
+}
+
+// Flushes what's left in the batch (like EndDrawing does) and starts counting a new frame, call right before EndDrawing
+void EndRenderStatsFrame(void)
+{
+    FlushBatch();
+
+    enum GameStateTypes state = GetGameState();
+    uint8_t i = (unsigned) state < NUMBER_OF_GAME_STATES ? state : NUMBER_OF_COUNTED_STATES - 1;
+
+    StateTotals[i].quads += CurrentFrame.quads;
+    StateTotals[i].draw_calls += CurrentFrame.draw_calls;
+    StateTotals[i].batch_flushes += CurrentFrame.batch_flushes;
+    StateTotals[i].texture_binds += CurrentFrame.texture_binds;
+    StateTotals[i].blend_switches += CurrentFrame.blend_switches;
+    StateTotals[i].target_switches += CurrentFrame.target_switches;
+    StateFrames[i]++;
+
+    LastFrame = CurrentFrame;
+    CurrentFrame = (RenderStats) {0};
+}
+
+// Gets the counts of the last finished frame
+RenderStats GetLastFrameRenderStats(void)
+{
+    return LastFrame;
+}
+
+// Gets the average counts per frame of every frame finished in a game state (frames gets the amount of frames, can be NULL)
+RenderStats GetGameStateRenderStats(enum GameStateTypes state, uint64_t * frames)
+{
+    uint8_t i = (unsigned) state < NUMBER_OF_GAME_STATES ? state : NUMBER_OF_COUNTED_STATES - 1;
+
+    if (frames) *frames = StateFrames[i];
+    if (!StateFrames[i]) return (RenderStats) {0};
+
+    return (RenderStats) {  StateTotals[i].quads / StateFrames[i],
+                            StateTotals[i].draw_calls / StateFrames[i],
+                            StateTotals[i].batch_flushes / StateFrames[i],
+                            StateTotals[i].texture_binds / StateFrames[i],
+                            StateTotals[i].blend_switches / StateFrames[i],
+                            StateTotals[i].target_switches / StateFrames[i]};
+}
+
+// Prints the average counts per frame of each game state
+void PrintRenderStats(void)
+{
+    printf("\nRender stats per frame (average) per game state:\n");
+    for (uint8_t i = 0; i < NUMBER_OF_COUNTED_STATES; i++)
+    {
+        uint64_t frames = 0;
+        RenderStats stats = GetGameStateRenderStats(i, &frames);
+        if (!frames) continue;
+        printf("  %-14s %8llu frames, %u quads, %u draw calls, %u flushes, %u texture binds, %u blend switches, %u target switches\n",
+                GetGameStateName(i), (unsigned long long) frames, stats.quads, stats.draw_calls, stats.batch_flushes,
+                stats.texture_binds, stats.blend_switches, stats.target_switches);
+    }
+}
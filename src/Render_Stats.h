@@ -0,0 +1,88 @@
+/*
+    Zlib License
+
+    Copyright (c) 2024 SpyterDev
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software
+        in a product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Counts what each frame costs the GPU: draw calls, batch flushes, texture binds, blend mode and render target switches
+// Any source file that includes this header (after Raylib) gets its drawing calls routed through the counters, which
+// follow the same rules rlgl uses to batch quads (a new draw call on every texture change, a flush on every blend mode
+// or render target change, when the batch is full and at the end of the frame)
+
+#pragma once
+
+#include "../Include/raylib.h"
+#include "Game_State.h"
+#include <stdint.h>
+
+typedef struct RenderStats
+{
+    uint32_t quads; // Quads pushed into the batch (one per texture draw / rectangle / glyph)
+    uint32_t draw_calls; // glDrawElements calls
+    uint32_t batch_flushes; // rlDrawRenderBatch calls that had something to draw
+    uint32_t texture_binds; // glBindTexture calls (one per draw call, plus one per SetTextureFilter / SetTextureWrap)
+    uint32_t blend_switches;
+    uint32_t target_switches; // BeginTextureMode / EndTextureMode
+} RenderStats;
+
+extern void TrackedDrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint);
+extern void TrackedDrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint);
+extern void TrackedDrawRectangle(int posX, int posY, int width, int height, Color color);
+extern void TrackedDrawRectangleRec(Rectangle rec, Color color);
+extern void TrackedDrawText(const char * text, int posX, int posY, int fontSize, Color color);
+extern void TrackedDrawTextPro(Font font, const char * text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint);
+extern void TrackedDrawFPS(int posX, int posY);
+extern void TrackedBeginTextureMode(RenderTexture2D target);
+extern void TrackedEndTextureMode(void);
+extern void TrackedBeginBlendMode(int mode);
+extern void TrackedEndBlendMode(void);
+extern void TrackedSetTextureFilter(Texture2D texture, int filter);
+extern void TrackedSetTextureWrap(Texture2D texture, int wrap);
+
+// Flushes what's left in the batch (like EndDrawing does) and starts counting a new frame, call right before EndDrawing
+extern void EndRenderStatsFrame(void);
+
+// Gets the counts of the last finished frame
+extern RenderStats GetLastFrameRenderStats(void);
+
+// Gets the average counts per frame of every frame finished in a game state (frames gets the amount of frames, can be NULL)
+extern RenderStats GetGameStateRenderStats(enum GameStateTypes state, uint64_t * frames);
+
+// Prints the average counts per frame of each game state
+extern void PrintRenderStats(void);
+
+#ifndef RENDER_STATS_IMPLEMENTATION
+
+// Variadic so compound literal arguments (which have unprotected commas) pass through
+
+#define DrawTexturePro(...) TrackedDrawTexturePro(__VA_ARGS__)
+#define DrawTextureEx(...) TrackedDrawTextureEx(__VA_ARGS__)
+#define DrawRectangle(...) TrackedDrawRectangle(__VA_ARGS__)
+#define DrawRectangleRec(...) TrackedDrawRectangleRec(__VA_ARGS__)
+#define DrawText(...) TrackedDrawText(__VA_ARGS__)
+#define DrawTextPro(...) TrackedDrawTextPro(__VA_ARGS__)
+#define DrawFPS(...) TrackedDrawFPS(__VA_ARGS__)
+#define BeginTextureMode(...) TrackedBeginTextureMode(__VA_ARGS__)
+#define EndTextureMode(...) TrackedEndTextureMode(__VA_ARGS__)
+#define BeginBlendMode(...) TrackedBeginBlendMode(__VA_ARGS__)
+#define EndBlendMode(...) TrackedEndBlendMode(__VA_ARGS__)
+#define SetTextureFilter(...) TrackedSetTextureFilter(__VA_ARGS__)
+#define SetTextureWrap(...) TrackedSetTextureWrap(__VA_ARGS__)
+
+#endif
@@ -28,6 +28,8 @@
 #include "../Include/raylib.h"
 #include "Battle_Rework.h"
 #include "Save.h"
+#include "Hitch_Recorder.h"
+#include "Alloc_Tracker.h"
 #define INVALID_ANIMATRONIC ((struct Animatronic) {0})
 
 typedef struct Selection
@@ -85,6 +87,29 @@ static struct
     cJSON * y;
 } Last_Location = {0};
 
+// cJSON_Print allocates a new string every call (and it was never freed), so the save is printed into one reused buffer instead
+
+#define MAX_SAVE_TEXT (16 * 1024 * 1024)
+
+static char * SaveText = NULL;
+static size_t SaveTextCapacity = 0;
+
+// Prints SaveJSON into SaveText (only allocates when the save has outgrown it), returns NULL on failure
+static char * PrintSaveJSON(void)
+{
+    while (!SaveText || !cJSON_PrintPreallocated(SaveJSON, SaveText, SaveTextCapacity, 1))
+    {
+        size_t capacity = SaveTextCapacity ? SaveTextCapacity * 2 : 4096;
+        if (capacity > MAX_SAVE_TEXT) return NULL;
+
+        char * resized = realloc(SaveText, capacity);
+        if (!resized) return NULL;
+        SaveText = resized;
+        SaveTextCapacity = capacity;
+    }
+    return SaveText;
+}
+
 // Returns the cJSON of a path
 cJSON * cJSON_LoadJSON(const char * path)
 {
@@ -99,13 +124,17 @@ cJSON * cJSON_LoadJSON(const char * path)
 
     // Creating copy in heap
     char * jsonText = malloc(jsonTextLength);
-    if (!jsonText) return NULL;
-    fread(jsonText, 1, jsonTextLength, jsonFile);
+    if (!jsonText) 
+    {
+        fclose(jsonFile);
+        return NULL;
+    }
+    jsonTextLength = fread(jsonText, 1, jsonTextLength, jsonFile);
     fclose(jsonFile);
 
-    // Parses tilemap json
+    // Parses save json (the text isn't null-terminated so the length is passed)
 
-    cJSON * jsonParsed =  cJSON_Parse(jsonText);
+    cJSON * jsonParsed =  cJSON_ParseWithLength(jsonText, jsonTextLength);
 
     free(jsonText);
     return jsonParsed;
@@ -117,6 +146,10 @@ void CreateSave(const char * path)
 
     if (path) strcpy_s(Selected_Save, sizeof(Selected_Save), path);
 
+    // Frees the previously loaded save
+
+    cJSON_Delete(SaveJSON);
+
     SaveJSON = cJSON_CreateObject();
 
     ChipsJSON = cJSON_AddArrayToObject(SaveJSON, "Chips");
@@ -148,7 +181,8 @@ void CreateSave(const char * path)
     {
         const char * directory = GetDirectoryPath(path);
         if (!DirectoryExists(directory)) MakeDirectory(directory);
-        SaveFileText(path, cJSON_Print(SaveJSON));
+        char * text = PrintSaveJSON();
+        if (text) SaveFileText(path, text);
     }
 }
 
@@ -161,6 +195,7 @@ void LoadSave(const char * path)
 
     if (path) strcpy_s(Selected_Save, sizeof(Selected_Save), path);
 
+    cJSON_Delete(SaveJSON);
     SaveJSON = cJSON_LoadJSON(path);
     printf("\nLoaded at %p\n", SaveJSON);
     if (!SaveJSON) return CreateSave(path);
@@ -213,7 +248,11 @@ void WriteSave(Vector2 LastLocation)
     printf("%u, %u\n", (uint16_t)LastLocation.x, (uint16_t)LastLocation.y);
     cJSON_SetIntValue(Last_Location.y, (uint16_t)LastLocation.y);
 
-    SaveFileText(Selected_Save, cJSON_Print(SaveJSON));
+    uint64_t start = GetHitchTimestamp();
+    char * text = PrintSaveJSON();
+    if (text) SaveFileText(Selected_Save, text);
+    else printf("SAVE: Couldn't print the save!\n");
+    RecordHitchEvent(HITCH_SAVE, Selected_Save, GetHitchTimestamp() - start);
 }
 
 uint8_t GetZone_Level(void)
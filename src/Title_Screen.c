@@ -25,11 +25,15 @@
 #include "Background.h"
 #include "Game_State.h"
 #include "Particle.h"
+#define ASSET_SUBSYSTEM "Title_Screen"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
 #include "Particle_Updaters.h"
 #include "UI.h"
 #include <stdint.h>
 #include <stdio.h>
 #include <time.h>
+#include "rayclock.h"
 
 #define TITLE_SECONDS_TO_CENTRE 3
 #define PARTY_SECONDS_TO_CENTRE 3
@@ -106,7 +110,7 @@ void ResetTitleScreen(void)
 {
     SetWindowTitle("FNaF World: C Edition (Overworld Preview) - Title Screen");
 
-    StartTime = clock();
+    StartTime = Rayclock();
     
     UITitle.visual.animation.Clock = StartTime;
 
@@ -124,7 +128,7 @@ void ResetTitleScreen(void)
 
 void UpdateTitle(void) 
 {
-    register float timeSinceStart = (float)(clock() - StartTime) / CLOCKS_PER_SEC;
+    register float timeSinceStart = (float)(Rayclock() - StartTime) / CLOCKS_PER_SEC;
     UITitle.x = -GetOutsideWindowX_u16(UITitle.visual.animation_V2.TileSize_x) + timeSinceStart * (GetOutsideWindowY_u16(UITitle.visual.animation_V2.TileSize_y) / TITLE_SECONDS_TO_CENTRE);
 
     if (UITitle.x > 0)
@@ -137,14 +141,14 @@ void UpdateTitle(void)
 
 void UpdateParty(void) 
 {
-    register float timeSinceStart = (float)(clock() - StartTime) / CLOCKS_PER_SEC;
+    register float timeSinceStart = (float)(Rayclock() - StartTime) / CLOCKS_PER_SEC;
     UIParty.y = GetOutsideWindowY(UIParty.visual.texture) + timeSinceStart * -(GetOutsideWindowY(UIParty.visual.texture) / PARTY_SECONDS_TO_CENTRE);
     UIParty.y = UIParty.y <= 0.26 ? 0.26 : UIParty.y;
 }
 
 void UpdatePlay(void) 
 {
-    register float timeSinceStart = (float)(clock() - StartTime) / CLOCKS_PER_SEC;
+    register float timeSinceStart = (float)(Rayclock() - StartTime) / CLOCKS_PER_SEC;
     UIPlay.graphic.x = GetOutsideWindowX_u16(UIPlay.graphic.visual.animation_V2.TileSize_x) + timeSinceStart * -(GetOutsideWindowX_u16(UIPlay.graphic.visual.animation_V2.TileSize_x) / START_SECONDS_TO_CENTRE);
     UIPlay.graphic.x = UIPlay.graphic.x < 0 ? 0: UIPlay.graphic.x;
 }
@@ -152,11 +156,11 @@ void UpdatePlay(void)
 void CreateTitlestars(void)
 {
     static clock_t timeSinceLastParticle = 0;
-    if (clock() - timeSinceLastParticle > 50 && UIParty.y <= 0.26) 
+    if (Rayclock() - timeSinceLastParticle > 50 && UIParty.y <= 0.26) 
     {
         float degrees = GetRandomValue(0, 200 *PI)/100.;
         CreateParticleEx(ParticleStars, 0, 0, cosf(degrees), sinf(degrees), 80, NULL);
-        timeSinceLastParticle = clock();
+        timeSinceLastParticle = Rayclock();
     }
 }
 
@@ -25,12 +25,16 @@
 #include "Animation.h"
 #include <stdlib.h>
 #include "input.h"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
 #include <math.h>
 #include "../Include/rlgl.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <time.h>
+#include "rayclock.h"
+#include "Alloc_Tracker.h"
 
 // Gets the screen ratio
 float GetScreenRatio(void)
@@ -256,41 +260,13 @@ UIElement CreateUIElement(UIVisual visual, float x, float y, float scale)
 // Scales and Renders a UIElement
 void RenderUIElement(const UIElement * element) 
 {
-    register float scale = element -> scale * GetScreenScale();
-    switch (element -> visual.type) {
-
-        case UIanimation:
-            RenderAnimation(&element -> visual.animation, 
-                            element -> x, 
-                            element -> y, 
-                            scale, 0);
-            return;
-        case UItexture:
-            RenderUITexture(element -> visual.texture, 
-                            element -> x, 
-                            element -> y, 
-                            scale);
-            return;
-        case UItextureSnippet:
-            RenderUITextureSnippet( element -> visual.texture,
-                                    element -> x,
-                                    element -> y,
-                                    element -> visual.snippet);
-            break;
-        case UIanimationV2:
-            RenderAnimation_V2(&element -> visual.animation_V2, 
-                                element -> x, element -> y, 
-                                element -> scale, 0);
-            return;
-        default:
-            return;
-    }
+    RenderUIVisual(element -> x, element -> y, &element -> visual, element -> scale);
 }
 
 // Scales and Renders a UIButton
 void RenderUIButton(UIButton * button)
 {
-    if (button -> last_press && clock() - button -> last_press < button -> pressed_visual_duration)
+    if (button -> last_press && Rayclock() - button -> last_press < button -> pressed_visual_duration)
     {
         RenderUIVisual( button -> graphic.x, button -> graphic.y, 
                         &button -> pressed_visual, 
@@ -299,10 +275,26 @@ void RenderUIButton(UIButton * button)
 }
 
 // Scales and Renders a UIVisual at X, Y scaled
-void RenderUIVisual(float x, float y, UIVisual * visual, float scale)
+void RenderUIVisual(float x, float y, const UIVisual * visual, float scale)
 {
-    UIElement temp = (UIElement) {.visual=*visual, .x=x, .y=y, .scale=scale};
-    RenderUIElement(&temp);
+    register float screen_scale = scale * GetScreenScale();
+    switch (visual -> type) {
+
+        case UIanimation:
+            RenderAnimation(&visual -> animation, x, y, screen_scale, 0);
+            return;
+        case UItexture:
+            RenderUITexture(visual -> texture, x, y, screen_scale);
+            return;
+        case UItextureSnippet:
+            RenderUITextureSnippet(visual -> texture, x, y, visual -> snippet);
+            break;
+        case UIanimationV2:
+            RenderAnimation_V2(&visual -> animation_V2, x, y, scale, 0);
+            return;
+        default:
+            return;
+    }
 }
 
 // Scales and Renders text in UI space
@@ -377,14 +369,14 @@ void UpdateUIButton(UIButton * button)
 
     if (CheckCollisionPointRec(GetInputTap(), button_rect) && !button -> last_press)
     {
-        button -> last_press = clock();
+        button -> last_press = Rayclock();
         if (button -> pressed_visual.type == UIanimationV2)
         {
             button -> pressed_visual.animation_V2.Clock = button -> last_press;
         }
     }
 
-    if (button -> last_press && clock() - button -> last_press >= button -> press_update_delay)
+    if (button -> last_press && Rayclock() - button -> last_press >= button -> press_update_delay)
     {
         button -> press(button);
         button -> last_press = 0;
@@ -409,6 +401,10 @@ void DrawUITextureSpritesheetEx(Texture2D atlas, int16_t x, int16_t y, uint16_t
 {
     uint16_t adjustedWidth = atlas.width / (uint16_t) tileSize.x;
     adjustedWidth *= (uint16_t) tileSize.x; 
+
+    // Nothing to draw if the atlas didn't load (or is thinner than a tile)
+    if (!adjustedWidth) return;
+
     Rectangle source = {    (index * (uint16_t) tileSize.x) % adjustedWidth, 
                             (uint16_t)((float) (index * (uint16_t) tileSize.x) / adjustedWidth) * tileSize.y,
                             tileSize.x,
@@ -424,6 +420,10 @@ void DrawUITextureSpritesheetPro(Texture2D atlas, int16_t x, int16_t y, uint16_t
 {
     uint16_t adjustedWidth = atlas.width / (uint16_t) tileSize.x;
     adjustedWidth *= (uint16_t) tileSize.x; 
+
+    // Nothing to draw if the atlas didn't load (or is thinner than a tile)
+    if (!adjustedWidth) return;
+
     Rectangle source = {    (index * (uint16_t) tileSize.x) % adjustedWidth, 
                             (uint16_t)((float) (index * (uint16_t) tileSize.x) / adjustedWidth) * tileSize.y,
                             tileSize.x,
@@ -176,7 +176,7 @@ void DrawUITextureSpritesheetPro(Texture2D atlas, int16_t x, int16_t y, uint16_t
 void RenderUIElement(const UIElement * element);
 
 // Scales and Renders a UIVisual at X, Y scaled
-void RenderUIVisual(float x, float y, UIVisual * visual, float scale);
+void RenderUIVisual(float x, float y, const UIVisual * visual, float scale);
 
 // Scales and Renders text in UI space
 void RenderUIText(const char * text, float x, float y, float fontSize, enum UITextAlignment allignment, Font font, Color color);
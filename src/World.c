@@ -36,12 +36,20 @@
 #include <stdio.h>
 #include "Save.h"
 #include "input.h"
+#include "Profiler.h"
+#define ASSET_SUBSYSTEM "World"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
 #include <time.h>
+#include "rayclock.h"
 #include "World.h"
 
 #define WORLD_SIZE_X 1000
 #define WORLD_SIZE_Y 1000
 #define SKY_TINT (Color) {185, 255, 255, 255}
+#define PROJECT_ATLAS_COLUMNS 32 // Tiles per row of the textures LoadWorldProject packs sprite sheets into
+#define PROJECT_ATLAS_HEIGHT 2048 // Most pixels tall each of those textures can be before another page is started
+#define WORLD_PAGE_BATCH 1024 // Tiles RenderLayer sorts by page at a time when the tileset has more than one page
 
 // Refers index in tile dictionary
 WORLDTilemap * CurrentWorld = NULL;
@@ -49,16 +57,26 @@ WORLDTilemap * CurrentWorld = NULL;
 // Current tilemap spritesheet
 Music CurrentTheme = {0};
 uint16_t CurrentTileSize = 50;
-UITexture CurrentWorldSpriteSheet = {0};
+UITexture CurrentWorldPages[MAX_TILESET_PAGES] = {0}; // Spritesheets of the tileset, indexed by WORLDTileInfo.page
+uint8_t AmountOfWorldPages = 0;
+WORLDTileset * CurrentWorldTileset = NULL; // Source rect, page and FLAGS of every tile of CurrentWorldPages
+static _Bool WorldProjectLoaded = 0; // CurrentWorld and its spritesheets came from LoadWorldProject, so InitWorld keeps them
+static _Bool WorldOpaqueTilesFound = 0; // FindOpaqueTiles could read the pixels of the spritesheet (headless builds only get sizes)
 
 RenderTexture2D WorldVirtualScreen = {0};
 
+uint16_t VisibleWorldEntities = 0; // WORLDEntities that passed the camera culling this frame
+
 UITexture SunHeader = {0};
 UIVisual LegacyZoneEffect = {0};
 WORLDCamera WorldCamera = {0};
 
-WORLDEntity WorldBuildings_After[5] = {0}; // World Buildings rendered after Freddy
-WORLDEntity WorldBuildings_Pre[10] = {0}; // World Buildings rendered before Freddy
+// Entity placements of the overworld, see InitWorldObjects
+
+static WORLDObjectLayer * WorldObjects = NULL;
+static WORLDEntity NoWorldEntities[1] = {0}; // Used when an object type has no entities
+
+WORLDEntity * WorldBuildings = NoWorldEntities; // Ends with an entity without a visual
 WORLDEntity WorldWheel = {0}; // Note: The Ferris Wheel has to be seperate due to being behind trees
 
 WORLDEntity WORLDEntities[5] = {0};
@@ -66,15 +84,26 @@ WORLDEntity Lolbit[5] = {0};
 
 WORLDEntity Freddy = {0};
 
+// Zone of every tile of the zone layer (layer 0), baked when the tilemap is loaded
+
+static uint8_t * ZoneGrid = NULL;
+static uint16_t ZoneGridWidth = 0;
+static uint16_t ZoneGridHeight = 0;
+
+static uint8_t CurrentZone = FAZBEARHILLS - 1;
+
+static WORLDZoneListener ZoneListeners[MAX_ZONE_LISTENERS] = {0};
+static uint8_t AmountOfZoneListeners = 0;
+
 UIVisual FreddyIdle = {0};
 UIVisual FreddyWLeft = {0};
 UIVisual FreddyWUp = {0};
 UIVisual FreddyWRight = {0};
 UIVisual FreddyWDown = {0};
 
-WORLDEntity WorldZoneButtonUpdater[2];
-
-#define NUMBER_OF_BUTTONS (sizeof(WorldZoneButtonUpdater) / sizeof(WORLDEntity))
+// Walking on button n sets the zone level to n + 2, buttons without a visual are hidden
+WORLDEntity * WorldZoneButtonUpdater = NoWorldEntities;
+uint16_t AmountOfZoneButtons = 0;
 
 UIVisual ButtonUp = {0};
 UIVisual ButtonDown = {0};
@@ -103,15 +132,18 @@ typedef struct WORLDBox
     _Bool open;
 } WORLDBox;
 
-#define NUMBER_OF_CHIPS 7
-
-WORLDBox ChipBoxes[NUMBER_OF_CHIPS] = {0};
+WORLDBox * ChipBoxes = NULL;
+uint16_t AmountOfChipBoxes = 0;
 Texture2D ItemAtlas = {0};
 
-#define NUMBER_OF_MINES 2
+// Both end with an entity without a visual, the teleport targets are in the payloads of their objects
+WORLDEntity * Ent_MinesTeleporters = NoWorldEntities;
+WORLDEntity * Ex_MinesTeleporters = NoWorldEntities;
+static const WORLDObjectGroup * MineEntrances = NULL;
+static const WORLDObjectGroup * MineExits = NULL;
 
-WORLDEntity Ent_MinesTeleporters[NUMBER_OF_MINES];
-WORLDEntity Ex_MinesTeleporters[NUMBER_OF_MINES];
+// Tiles the zone warp buttons take Freddy to, warp n is used by WarpButtons[n]
+static const WORLDObjectGroup * WarpTargets = NULL;
 
 UITexture ZoneHeader[4] = {0};
 char * ZoneNames[] = {"Fazbear Hills", "Choppy's Woods", "Dusting Fields"};
@@ -146,20 +178,75 @@ WORLDEntity CreateWorldEntity(Vector2 position, Vector2 size, Vector2 velocity,
     return entity;
 }
 
+// Turns the zone layer's tile ids into a zone per tile so finding Freddy's zone is one lookup
+static void BakeZoneGrid(void)
+{
+    static const uint16_t ZoneIds[] = {32, 33, 46, 89}; // Zone layer tile of each WORLDZONES
+
+    free(ZoneGrid);
+    ZoneGrid = NULL;
+    ZoneGridWidth = ZoneGridHeight = 0;
+    if (!CurrentWorld || !CurrentWorld -> amount) return;
+
+    WORLDTilemapLayer * layer = CurrentWorld -> layers + 0;
+    uint16_t width = layer -> offsetX + layer -> sizeX;
+    uint16_t height = layer -> offsetY + layer -> sizeY;
+
+    ZoneGrid = malloc((size_t) width * height);
+    if (!ZoneGrid)
+    {
+        printf("WORLD: Couldn't allocate the zone grid!\n");
+        return;
+    }
+    memset(ZoneGrid, UNKNOWN_ZONE, (size_t) width * height);
+    ZoneGridWidth = width;
+    ZoneGridHeight = height;
+
+    for (uint16_t y = layer -> offsetY; y < height; y++)
+    {
+        for (uint16_t x = layer -> offsetX; x < width; x++)
+        {
+            WORLDTile id = AccessPositionInLayer(x, y, layer);
+            for (uint8_t zone = 0; zone < sizeof(ZoneIds) / sizeof(ZoneIds[0]); zone++)
+            {
+                if (id == ZoneIds[zone]) ZoneGrid[(size_t) y * width + x] = zone;
+            }
+        }
+    }
+}
+
+// Puts the TILE_SOLID tiles of the current tileset into the collision bit-grid and culls the tiles hidden by TILE_OPAQUE ones (once both are loaded)
+static void ApplyWorldTileset(void)
+{
+    if (!CurrentWorld || !CurrentWorldTileset) return;
+    if (!BuildCollisionGrid(CurrentWorld, CurrentWorldTileset)) printf("WORLD: Couldn't allocate the collision grid!\n");
+    if (!BakeTileOcclusion(CurrentWorld, CurrentWorldTileset)) printf("WORLD: Couldn't allocate the visible row spans!\n");
+}
+
 void LoadWorldTilemap(void)
 {
-    CurrentWorld = CreateTilemap("Assets/Overworld/Maps/Overworld/map.json");
+    WorldProjectLoaded = 0;
+    CurrentWorld = CreateTilemap("Assets/Overworld/maps/Overworld/map.json");
+    BakeZoneGrid();
+    ApplyWorldTileset();
 }
 
-void FreeTilemap(WORLDTilemap ** tilemap)
+// Makes (tilemap) the overworld tilemap and returns the previous one, the caller owns both (used by the tools)
+WORLDTilemap * SwapWorldTilemap(WORLDTilemap * tilemap)
 {
-    free((*tilemap) -> layers);
-    free(tilemap);
+    WORLDTilemap * previous = CurrentWorld;
+    CurrentWorld = tilemap;
+    BakeZoneGrid();
+    ApplyWorldTileset();
+    return previous;
 }
 
 void FreeWorldTilemap(void)
 {
-    FreeTilemap(&CurrentWorld);
+    FreeTilemap(CurrentWorld);
+    CurrentWorld = NULL;
+    WorldProjectLoaded = 0;
+    BakeZoneGrid();
 }
 
 float GetFloorTileScale(void)
@@ -167,35 +254,254 @@ float GetFloorTileScale(void)
     return GetScreenWidth() > GetScreenHeight() ? 1280 / 25. : 720 / 25.;
 }
 
+// Marks the tiles of a page (image) of a tileset without any transparent pixels as TILE_OPAQUE (see BakeTileOcclusion)
+// Returns 0 if the pixels of the image couldn't be read
+static _Bool FindOpaqueTiles(WORLDTileset * tileset, Image image, uint8_t page)
+{
+    Color * colors = image.data ? LoadImageColors(image) : NULL;
+    if (!colors) return 0;
+
+    uint16_t tileSize = tileset -> tileSize;
+    for (uint16_t id = 1; id < tileset -> amount; id++)
+    {
+        WORLDTileInfo * tile = tileset -> tiles + id;
+        if (tile -> page != page) continue;
+
+        _Bool opaque = 1;
+        for (uint16_t y = 0; y < tileSize && opaque; y++)
+        {
+            const Color * row = colors + (size_t) (tile -> sourceY + y) * image.width + tile -> sourceX;
+            for (uint16_t x = 0; x < tileSize && opaque; x++) opaque = row[x].a == 255;
+        }
+        if (opaque) tile -> FLAGS |= TILE_OPAQUE;
+    }
+
+    UnloadImageColors(colors);
+    return 1;
+}
+
+static void UnloadWorldPages(void)
+{
+    for (uint8_t i = 0; i < AmountOfWorldPages; i++)
+    {
+        if (CurrentWorldPages[i].height) UnloadTexture(CurrentWorldPages[i]);
+    }
+    AmountOfWorldPages = 0;
+}
+
 void SetWorldSpriteSheet(const char * path, uint16_t tileSize)
 {
-    if (CurrentWorldSpriteSheet.height)
+    UnloadWorldPages();
+    WorldProjectLoaded = 0;
+
+    // Decoded once for both the texture and FindOpaqueTiles
+
+    Image image = LoadImage(path);
+    CurrentWorldPages[0] = LoadTextureFromImage(image);
+    SetTextureFilter(CurrentWorldPages[0], TEXTURE_FILTER_POINT);
+    AmountOfWorldPages = 1;
+
+    // Source rects are worked out once here instead of for every tile drawn
+
+    FreeTileset(CurrentWorldTileset);
+    CurrentWorldTileset = CreateTileset(CurrentWorldPages[0].width, CurrentWorldPages[0].height, tileSize);
+    WorldOpaqueTilesFound = CurrentWorldTileset && FindOpaqueTiles(CurrentWorldTileset, image, 0);
+    UnloadImage(image);
+    ApplyWorldTileset();
+}
+
+// Adds another spritesheet to the overworld tileset as its next page, its tiles come after the ones already there
+// Returns the WORLDTile of its first tile (what the map's ids for it are offset by), 0 on failure
+WORLDTile AddWorldSpriteSheet(const char * path)
+{
+    if (!CurrentWorldTileset) return 0;
+
+    // Decoded once for both the texture and FindOpaqueTiles
+
+    Image image = LoadImage(path);
+    Texture2D texture = image.height ? LoadTextureFromImage(image) : (Texture2D) {0};
+    WORLDTile first = texture.height ? AddTilesetPage(CurrentWorldTileset, texture.width, texture.height) : 0;
+    if (!first)
     {
-        UnloadTexture(CurrentWorldSpriteSheet);
+        if (texture.height) UnloadTexture(texture);
+        UnloadImage(image);
+        return 0;
     }
-    CurrentWorldSpriteSheet = LoadTexture(path);
-    SetTextureFilter(CurrentWorldSpriteSheet, TEXTURE_FILTER_POINT);
+
+    SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+    CurrentWorldPages[AmountOfWorldPages] = texture;
+
+    FindOpaqueTiles(CurrentWorldTileset, image, AmountOfWorldPages++);
+    UnloadImage(image);
+
+    ApplyWorldTileset();
+    return first;
 }
 
-static void WarpButton_1(UIButton * button)
+// Decodes a sprite sheet embedded in a project file (runs on the map load threads, Raylib's image loading is thread safe)
+static void * DecodeWorldSpriteSheet(const unsigned char * data, size_t size)
 {
-    PlaySound(WarpSoundEffect);
-    Freddy.position = (Vector2) {   38 + 0.5 - Freddy.size.x / 2, 
-                                    21 + 0.5 - Freddy.size.y / 2};
+    Image * image = malloc(sizeof(Image));
+    if (!image) return NULL;
+
+    *image = size <= INT32_MAX ? LoadImageFromMemory(".png", data, size) : (Image) {0};
+    if (!image -> width || !image -> height)
+    {
+        free(image);
+        return NULL;
+    }
+    return image;
 }
 
-static void WarpButton_2(UIButton * button)
+// Frees an image returned by DecodeWorldSpriteSheet
+static void FreeWorldSpriteSheet(void * image)
 {
-    PlaySound(WarpSoundEffect);
-    Freddy.position = (Vector2) {   34 + 0.5 - Freddy.size.x / 2, 
-                                    32 + 0.5 - Freddy.size.y / 2};
+    UnloadImage(*(Image *) image);
+    free(image);
 }
 
-static void WarpButton_3(UIButton * button)
+// Loads the overworld tilemap and spritesheets from a Spritefusion project file, returns 1 on success
+// The tiles it uses are packed from its sprite sheets row by row in WORLDTile order into pages of up to
+// PROJECT_ATLAS_HEIGHT pixels, every page but the last is full so the tileset's ids line up with the map's
+// (WORLDTiles are in sprite sheet order, so each sheet's tiles end up together on as few pages as possible)
+_Bool LoadWorldProject(const char * path)
 {
+    WORLDSpriteSheets sheets;
+    WORLDTilemap * tilemap = CreateTilemapFromProject(path, DecodeWorldSpriteSheet, FreeWorldSpriteSheet, &sheets);
+    if (!tilemap) return 0;
+
+    if (!sheets.amountOfTiles)
+    {
+        printf("WORLD: \"%s\" has no sprite sheets!\n", path);
+        FreeSpriteSheets(&sheets, FreeWorldSpriteSheet);
+        FreeTilemap(tilemap);
+        return 0;
+    }
+
+    uint16_t tileSize = sheets.tileSize;
+    uint16_t columns = sheets.amountOfTiles < PROJECT_ATLAS_COLUMNS ? sheets.amountOfTiles : PROJECT_ATLAS_COLUMNS;
+    uint16_t pageRows = tileSize < PROJECT_ATLAS_HEIGHT ? PROJECT_ATLAS_HEIGHT / tileSize : 1;
+    uint32_t pageTiles = (uint32_t) columns * pageRows;
+    uint32_t pages = (sheets.amountOfTiles + pageTiles - 1) / pageTiles;
+
+    if (pages > MAX_TILESET_PAGES)
+    {
+        printf("WORLD: \"%s\" needs %u spritesheet pages (max %u)!\n", path, pages, MAX_TILESET_PAGES);
+        FreeSpriteSheets(&sheets, FreeWorldSpriteSheet);
+        FreeTilemap(tilemap);
+        return 0;
+    }
+
+    // The pages and tileset are only swapped in once all of them were made, so a failure leaves the current overworld as it was
+
+    UITexture textures[MAX_TILESET_PAGES] = {0};
+    WORLDTileset * tileset = NULL;
+    _Bool failed = 0;
+
+    for (uint32_t page = 0; page < pages && !failed; page++)
+    {
+        uint32_t first = page * pageTiles + 1;
+        uint32_t amount = sheets.amountOfTiles - first + 1 < pageTiles ? sheets.amountOfTiles - first + 1 : pageTiles;
+        Image atlas = GenImageColor(columns * tileSize, (amount + columns - 1) / columns * tileSize, BLANK);
+
+        for (uint32_t id = first; id < first + amount; id++)
+        {
+            const Image * sheet = sheets.images[sheets.tiles[id].sheet];
+            uint16_t tile = sheets.tiles[id].tile;
+            uint16_t sheetColumns = sheet -> width / tileSize;
+
+            // Tiles past the edge of their sheet stay empty
+
+            if (!sheetColumns || tile >= sheetColumns * (sheet -> height / tileSize)) continue;
+
+            Rectangle source = {tile % sheetColumns * tileSize, tile / sheetColumns * tileSize, tileSize, tileSize};
+            Rectangle dest = {(id - first) % columns * tileSize, (id - first) / columns * tileSize, tileSize, tileSize};
+            ImageDraw(&atlas, *sheet, source, dest, WHITE);
+        }
+
+        textures[page] = LoadTextureFromImage(atlas);
+        SetTextureFilter(textures[page], TEXTURE_FILTER_POINT);
+
+        if (!page) tileset = CreateTileset(atlas.width, atlas.height, tileSize);
+        failed = !textures[page].id || !tileset || (page && AddTilesetPage(tileset, atlas.width, atlas.height) != first);
+        if (!failed) FindOpaqueTiles(tileset, atlas, page);
+        UnloadImage(atlas);
+    }
+    FreeSpriteSheets(&sheets, FreeWorldSpriteSheet);
+
+    if (failed)
+    {
+        printf("WORLD: Couldn't make the spritesheet pages of \"%s\"!\n", path);
+        for (uint32_t page = 0; page < pages; page++)
+        {
+            if (textures[page].id) UnloadTexture(textures[page]);
+        }
+        FreeTileset(tileset);
+        FreeTilemap(tilemap);
+        return 0;
+    }
+
+    UnloadWorldPages();
+    memcpy(CurrentWorldPages, textures, sizeof(textures));
+    AmountOfWorldPages = pages;
+    FreeTileset(CurrentWorldTileset);
+    CurrentWorldTileset = tileset;
+
+    FreeTilemap(CurrentWorld);
+    CurrentWorld = tilemap;
+    WorldProjectLoaded = 1;
+    BakeZoneGrid();
+    ApplyWorldTileset();
+    return 1;
+}
+
+// Sets the FLAGS of the current spritesheet's tiles from a tile metadata JSON (see LoadTilesetFlags)
+// Its "opaque" list is only there for headless builds, when the spritesheet's pixels were read they win and any tile
+// the list gets wrong is printed (so the list doesn't go stale unnoticed when the spritesheet is edited)
+void SetWorldTileFlags(const char * path)
+{
+    if (!CurrentWorldTileset) return;
+
+    WORLDTileset * tileset = CurrentWorldTileset;
+    uint8_t * found = WorldOpaqueTilesFound ? malloc(tileset -> amount) : NULL;
+    if (found)
+    {
+        for (uint16_t id = 0; id < tileset -> amount; id++)
+        {
+            found[id] = tileset -> tiles[id].FLAGS & TILE_OPAQUE;
+            tileset -> tiles[id].FLAGS &= ~TILE_OPAQUE;
+        }
+    }
+
+    LoadTilesetFlags(tileset, path);
+
+    if (found)
+    {
+        for (uint16_t id = 1; id < tileset -> amount; id++)
+        {
+            uint8_t listed = tileset -> tiles[id].FLAGS & TILE_OPAQUE;
+            if (listed == found[id]) continue;
+
+            // Spritefusion ids like in the JSON
+            printf("WORLD: Tile %u is%s opaque in \"%s\" but is%s in the spritesheet!\n", id - 1, listed ? "" : "n't", path, found[id] ? "" : "n't");
+            tileset -> tiles[id].FLAGS = (tileset -> tiles[id].FLAGS & ~TILE_OPAQUE) | found[id];
+        }
+        free(found);
+    }
+
+    ApplyWorldTileset();
+}
+
+// Takes Freddy to the middle of the warp object of the button
+static void WarpButtonPress(UIButton * button)
+{
+    uint16_t i = (_WarpButton *) button - WarpButtons;
+    if (!WarpTargets || i >= WarpTargets -> amount) return;
+
+    const WORLDObject * warp = WarpTargets -> objects + i;
     PlaySound(WarpSoundEffect);
-    Freddy.position = (Vector2) {   19 + 0.5 - Freddy.size.x / 2, 
-                                    34 + 0.5 - Freddy.size.y / 2};
+    Freddy.position = (Vector2) {   warp -> x + warp -> width / 2 - Freddy.size.x / 2, 
+                                    warp -> y + warp -> height / 2 - Freddy.size.y / 2};
 }
 
 static void SaveButtonPress(UIButton * button)
@@ -210,23 +516,87 @@ static void InitOpenedChipBoxes(void)
     uint8_t chip_ids[21];
     GetChipInv(&chip_ids);
 
-    for (uint8_t i = 0; i < 21; i++)
+    for (uint16_t i = 0; i < AmountOfChipBoxes; i++)
     {
-        ChipBoxes[i].open = chip_ids[i];
+        if (ChipBoxes[i].content.type != CHIP || ChipBoxes[i].content.id >= sizeof(chip_ids)) continue;
+        ChipBoxes[i].open = chip_ids[ChipBoxes[i].content.id];
     }
 }
 
+// Both joystick skins stay loaded so zone changes only have to swap between them
+enum JoystickBackgrounds
+{
+    JOYSTICK_BLACK, JOYSTICK_BLUE
+};
+
+static Texture2D JoystickBackgrounds[2] = {0};
+
 static void InitJoystick(void)
 {
-    Mobile_Joystick.background = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_black.png");
+    if (!IsTextureValid(JoystickBackgrounds[JOYSTICK_BLACK]))
+    {
+        JoystickBackgrounds[JOYSTICK_BLACK] = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_black.png");
+        JoystickBackgrounds[JOYSTICK_BLUE] = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_blue.png");
+        SetTextureFilter(JoystickBackgrounds[JOYSTICK_BLACK], TEXTURE_FILTER_BILINEAR);
+        SetTextureFilter(JoystickBackgrounds[JOYSTICK_BLUE], TEXTURE_FILTER_BILINEAR);
+    }
+
+    Mobile_Joystick.background = JoystickBackgrounds[JOYSTICK_BLACK];
     Mobile_Joystick.knob = LoadTexture("Assets/Overworld/UI_Touch/joystick/joystick_knob.png");
     Mobile_Joystick.velocity = (Vector2) {0, 0};
     Mobile_Joystick.x = -0.65;
     Mobile_Joystick.y = 0.5;
 
-    SetTextureFilter( Mobile_Joystick.background, TEXTURE_FILTER_BILINEAR);
     SetTextureFilter( Mobile_Joystick.knob, TEXTURE_FILTER_BILINEAR);
 }
+// Bulk allocates the entities of an object group with one visual, the array ends with an entity without a visual
+static WORLDEntity * CreateObjectEntities(const WORLDObjectGroup * group, UIVisual * visual)
+{
+    WORLDEntity * entities = group ? calloc(group -> amount + 1, sizeof(WORLDEntity)) : NULL;
+    if (!entities) return NoWorldEntities;
+
+    for (uint32_t i = 0; i < group -> amount; i++)
+    {
+        const WORLDObject * object = group -> objects + i;
+        entities[i] = CreateWorldEntity((Vector2) {object -> x, object -> y}, 
+                                        (Vector2) {object -> width, object -> height}, 
+                                        (Vector2) {0, 0}, 
+                                        visual, 
+                                        1, 
+                                        0, 
+                                        NULL, 
+                                        object -> depth);
+    }
+    return entities;
+}
+
+static void FreeObjectEntities(WORLDEntity ** entities)
+{
+    if (*entities != NoWorldEntities) free(*entities);
+    *entities = NoWorldEntities;
+}
+
+// Loads the entity placements of the overworld, the Init functions below make the entities of each object type from it
+static void InitWorldObjects(void)
+{
+    FreeObjectEntities(&WorldBuildings);
+    FreeObjectEntities(&WorldZoneButtonUpdater);
+    FreeObjectEntities(&Ent_MinesTeleporters);
+    FreeObjectEntities(&Ex_MinesTeleporters);
+    free(ChipBoxes);
+    ChipBoxes = NULL;
+    AmountOfChipBoxes = 0;
+    AmountOfZoneButtons = 0;
+
+    FreeObjectLayer(WorldObjects);
+    WorldObjects = LoadObjectLayer("Assets/Overworld/maps/Overworld/objects.json");
+
+    MineEntrances = GetObjectGroup(WorldObjects, "mine_entrance");
+    MineExits = GetObjectGroup(WorldObjects, "mine_exit");
+    WarpTargets = GetObjectGroup(WorldObjects, "warp");
+}
+
+// Mine entrances and exits, payload: the tile position they take Freddy to
 static void InitMines(void)
 {
     static Texture2D mine_atlas = {0};
@@ -240,124 +610,53 @@ static void InitMines(void)
     mine_front = CreateUIVisual_UITextureSnippet(mine_atlas, (Rectangle) {0, 0, 113, 75}, WHITE);
     mine_back = CreateUIVisual_UITextureSnippet(mine_atlas, (Rectangle) {113, 0, 80, 53}, WHITE);
 
-    Ent_MinesTeleporters[0] = CreateWorldEntity((Vector2){44, 31},
-                                                (Vector2){2, 2}, 
-                                                (Vector2) {0, 0}, 
-                                                &mine_front, 
-                                                1, 
-                                                0, 
-                                                NULL, 
-                                                3);
-    Ent_MinesTeleporters[1] = CreateWorldEntity((Vector2){8, 21}, 
-                                                (Vector2){2, 2}, 
-                                                (Vector2) {0, 0}, 
-                                                &mine_front, 
-                                                1, 
-                                                0, 
-                                                NULL, 
-                                                3);
-
-    Ex_MinesTeleporters[0] = CreateWorldEntity( (Vector2){29, 72}, 
-                                                (Vector2){1, 1}, 
-                                                (Vector2) {0, 0}, 
-                                                &mine_back, 
-                                                1, 
-                                                0, 
-                                                NULL, 
-                                                3);
-    Ex_MinesTeleporters[1] = CreateWorldEntity( (Vector2){36, 62}, 
-                                                (Vector2){1, 1}, 
-                                                (Vector2) {0, 0}, 
-                                                &mine_back, 
-                                                1, 
-                                                0, 
-                                                NULL, 
-                                                3);
+    Ent_MinesTeleporters = CreateObjectEntities(MineEntrances, &mine_front);
+    Ex_MinesTeleporters = CreateObjectEntities(MineExits, &mine_back);
 }
+
+// Chests, payload: the WORLDItemType of their content and its id (Faz-tokens: the amount)
 static void InitBoxes(void)
 {
     static UIVisual grey_chip_chest = {0};
 
     grey_chip_chest = CreateUIVisual_UITextureSnippet(ItemAtlas, (Rectangle) {0,0, 50, 50}, WHITE);
 
-    // Initizing boxes
-
-    ChipBoxes[0] = (WORLDBox) {{CHIP, .id=0 }, 
-                                CreateWorldEntity(  (Vector2) {46, 12},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-    
-    ChipBoxes[1] = (WORLDBox) {{CHIP, .id=1 }, 
-                                CreateWorldEntity(  (Vector2) {38, 7},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-
-    ChipBoxes[2] = (WORLDBox) {{CHIP, .id=2 }, 
-                                CreateWorldEntity(  (Vector2) {50, 22},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-    
-    ChipBoxes[3] = (WORLDBox) {{CHIP, .id=3 }, 
-                                CreateWorldEntity(  (Vector2) {26, 29},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-    
-    ChipBoxes[4] = (WORLDBox) {{CHIP, .id=4 }, 
-                                CreateWorldEntity(  (Vector2) {15, 27},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-    
-    ChipBoxes[5] = (WORLDBox) {{CHIP, .id=5 }, 
-                                CreateWorldEntity(  (Vector2) {0, 0},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
-
-    ChipBoxes[6] = (WORLDBox) {{CHIP, .id=6 }, 
-                                CreateWorldEntity(  (Vector2) {49, 18},
-                                                    (Vector2) {1, 1},
-                                                    (Vector2) {0, 0},
-                                                    &grey_chip_chest, 
-                                                    1, 
-                                                    0, 
-                                                    NULL, 
-                                                    3), 
-                                0};
+    const WORLDObjectGroup * chests = GetObjectGroup(WorldObjects, "chest");
+    ChipBoxes = chests ? calloc(chests -> amount, sizeof(WORLDBox)) : NULL;
+    if (!ChipBoxes) return;
+    AmountOfChipBoxes = chests -> amount;
+
+    for (uint16_t i = 0; i < AmountOfChipBoxes; i++)
+    {
+        const WORLDObject * chest = chests -> objects + i;
+        float type = chest -> payload[0];
+        float value = chest -> payload[1];
+        float max_value = type == FAZTOKENS ? UINT16_MAX : UINT8_MAX;
+
+        // A bad entry in the objects would make an item HandleSingleBoxCollision doesn't know, the chest is left empty instead
+        WORLDItem content = {.type = FAZTOKENS, .token_amount = 0};
+        if (!(type >= FAZTOKENS && type <= BYTE && value >= 0 && value <= max_value))
+        {
+            printf("WORLD: Invalid chest content (%g, %g) at (%g, %g)!\n", type, value, chest -> x, chest -> y);
+        }
+        else
+        {
+            content.type = (enum WORLDItemType) type;
+            if (content.type == FAZTOKENS) content.token_amount = (uint16_t) value;
+            else content.id = (uint8_t) value;
+        }
+
+        ChipBoxes[i] = (WORLDBox) {content, 
+                                    CreateWorldEntity(  (Vector2) {chest -> x, chest -> y},
+                                                        (Vector2) {chest -> width, chest -> height},
+                                                        (Vector2) {0, 0},
+                                                        &grey_chip_chest, 
+                                                        1, 
+                                                        0, 
+                                                        NULL, 
+                                                        chest -> depth), 
+                                    0};
+    }
     InitOpenedChipBoxes();
 }
 
@@ -408,55 +707,35 @@ static void InitLolbit(void)
                                             NULL, 2);
 }
 
-static void InitBuildings_Pre(void)
+// Buildings, payload: which of the building visuals below they use
+static void InitBuildings(void)
 {
-    static UIVisual chimney_freddy = {0};
+    enum BuildingVisuals
+    {
+        CHIMNEY_FREDDY, WINDMILL, TURBINE, NUMBER_OF_BUILDING_VISUALS
+    };
+    static UIVisual visuals[NUMBER_OF_BUILDING_VISUALS] = {0};
 
-    chimney_freddy = CreateUIVisual_UIAnimation_V2( "Assets/Overworld/NPCs/chimney_freddy.png", 
-                                                    15, 
-                                                    31, 
-                                                    (Vector2) {50, 50}, 
-                                                    WHITE);
-    WorldBuildings_Pre[0] = CreateWorldEntity(  (Vector2) {8, 19.25}, 
-                                                (Vector2) {1,1}, 
-                                                (Vector2) {0,0}, 
-                                                &chimney_freddy, 
-                                                1, 
-                                                0, 
-                                                NULL, 3);
-}
-
-static void InitBuildings_After(void)
-{
-    static UIVisual turbine = {0};
-    static UIVisual windmill = {0};
-
-    if (!turbine.type) turbine = CreateUIVisual_UIAnimation_V2("Assets/Overworld/Buildings/turbine_atlas.png", 30, 10, (Vector2) {50, 100}, WHITE);
-    if (!windmill.type) windmill = CreateUIVisual_UIAnimation_V2("Assets/Overworld/Buildings/windmill_atlas.png", 30, 20, (Vector2) {200, 200}, WHITE);
-
-    WorldBuildings_After[0] = CreateWorldEntity((Vector2) {31.5, 17}, 
-                                                (Vector2) {0,0}, 
-                                                (Vector2) {0,0}, 
-                                                &windmill,
-                                                1, 
-                                                0,
-                                                NULL,1);
-    WorldBuildings_After[1] = CreateWorldEntity((Vector2) {33, 29.375}, 
-                                                (Vector2) {1,2}, 
-                                                (Vector2) {0,0}, 
-                                                &turbine,
-                                                1, 
-                                                0, 
-                                                NULL, 1);
-    WorldBuildings_After[2] = CreateWorldEntity((Vector2) {35, 29.375}, 
-                                                (Vector2) {1,2}, 
-                                                (Vector2) {0,0}, 
-                                                &turbine,  
-                                                1, 
-                                                0, 
-                                                NULL, 1);
+    visuals[CHIMNEY_FREDDY] = CreateUIVisual_UIAnimation_V2("Assets/Overworld/NPCs/chimney_freddy.png", 
+                                                            15, 
+                                                            31, 
+                                                            (Vector2) {50, 50}, 
+                                                            WHITE);
+    if (!visuals[TURBINE].type) visuals[TURBINE] = CreateUIVisual_UIAnimation_V2("Assets/Overworld/Buildings/turbine_atlas.png", 30, 10, (Vector2) {50, 100}, WHITE);
+    if (!visuals[WINDMILL].type) visuals[WINDMILL] = CreateUIVisual_UIAnimation_V2("Assets/Overworld/Buildings/windmill_atlas.png", 30, 20, (Vector2) {200, 200}, WHITE);
+
+    const WORLDObjectGroup * buildings = GetObjectGroup(WorldObjects, "building");
+    WorldBuildings = CreateObjectEntities(buildings, NULL);
+    if (WorldBuildings == NoWorldEntities) return;
+
+    for (uint32_t i = 0; i < buildings -> amount; i++)
+    {
+        uint8_t visual = buildings -> objects[i].payload[0];
+        WorldBuildings[i].visual = visuals + (visual < NUMBER_OF_BUILDING_VISUALS ? visual : CHIMNEY_FREDDY);
+    }
 }
 
+// Zone buttons, payload: 1 if the button is shown, 0 if it's hidden
 static void InitZoneButtons(void)
 {
     ButtonUp = CreateUIVisual_UITextureSnippet( ItemAtlas,   
@@ -466,40 +745,125 @@ static void InitZoneButtons(void)
                                                     (Rectangle) {100, 50, 50, 50}, 
                                                     WHITE);
 
-    
+    const WORLDObjectGroup * buttons = GetObjectGroup(WorldObjects, "zone_button");
+    WorldZoneButtonUpdater = CreateObjectEntities(buttons, &ButtonUp);
+    if (WorldZoneButtonUpdater == NoWorldEntities) return;
+    AmountOfZoneButtons = buttons -> amount;
 
-    WorldZoneButtonUpdater[0] = CreateWorldEntity(  (Vector2) {32, 32}, 
-                                                    (Vector2) {1,1}, 
-                                                    (Vector2) {0,0}, 
-                                                    &ButtonUp,  
-                                                    1, 
-                                                    0, 
-                                                    NULL, 1);
-
-    WorldZoneButtonUpdater[1] = CreateWorldEntity(  (Vector2) {19, 34}, 
-                                                    (Vector2) {1,1}, 
-                                                    (Vector2) {0,0}, 
-                                                    NULL,  
-                                                    1, 
-                                                    0, 
-                                                    NULL, 1);
-
-    for (uint8_t i = 2; i <= GetZone_Level() && i - 2 < NUMBER_OF_BUTTONS; i++)
+    for (uint16_t i = 0; i < AmountOfZoneButtons; i++)
     {
-        if (i - 2 == 1) continue;
-        WorldZoneButtonUpdater[i - 2].visual = &ButtonDown;
+        if (!buttons -> objects[i].payload[0]) WorldZoneButtonUpdater[i].visual = NULL;
+        else if (i + 2 <= GetZone_Level()) WorldZoneButtonUpdater[i].visual = &ButtonDown;
     }
 }
 
+// Fazbear Hills and Choppy's Woods (and anywhere outside the zones) share their theme and zone effect
+static enum WORLDZONES GetZoneAssets(uint8_t zone)
+{
+    if (zone + 1 == DUSTINGFIELDS || zone + 1 == MYSTERIOUSMINES) return zone + 1;
+    return FAZBEARHILLS;
+}
+
+// Zone listener, swaps the theme
+static void UpdateZoneTheme(uint8_t exited, uint8_t entered)
+{
+    if (GetZoneAssets(exited) == GetZoneAssets(entered)) return;
+
+    PROFILE_SCOPE("UpdateZoneTheme: Load");
+
+    UnloadMusicStream(CurrentTheme);
+    switch (GetZoneAssets(entered)) 
+    {
+        case DUSTINGFIELDS:
+            CurrentTheme = LoadMusicStream("Assets/Themes/dustingfields.mp3");
+            break;
+        case MYSTERIOUSMINES:
+            CurrentTheme = LoadMusicStream("Assets/Themes/mysteriousmines.mp3");
+            break;
+        default:
+            CurrentTheme = LoadMusicStream("Assets/Themes/fazbearhills.mp3");
+    }
+
+    CurrentTheme.looping = 1;
+    PlayMusicStream(CurrentTheme);
+}
+
+// Zone listener, swaps the zone effect
+static void UpdateZoneEffect(uint8_t exited, uint8_t entered)
+{
+    if (GetZoneAssets(exited) == GetZoneAssets(entered)) return;
+
+    PROFILE_SCOPE("UpdateZoneEffect: Load");
+
+    FreeUIVisual(&LegacyZoneEffect);
+    
+    memset(&LegacyZoneEffect, 0, sizeof(UIVisual));
+    switch (GetZoneAssets(entered)) 
+    {
+        case DUSTINGFIELDS:
+            LegacyZoneEffect = CreateUIVisual_UIAnimation_V2(   "Assets/Overworld/Zone_Effects/dusting_fields_effect.png", 
+                                                                60, 11,
+                                                                (Vector2) {800, 480}, WHITE);
+            SetTextureFilter(LegacyZoneEffect.animation_V2.Atlas, TEXTURE_FILTER_BILINEAR);
+            FlushParticles();
+            break;
+        case MYSTERIOUSMINES:
+            LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/mysterious_mines_effect.png", WHITE);
+            FlushParticles();
+            break;
+        default:
+            LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/sun_effect_mod.png", SKY_TINT);
+            SetTextureFilter(LegacyZoneEffect.texture, TEXTURE_FILTER_BILINEAR);
+    }
+}
+
+// Zone listener, swaps the joystick background
+static void UpdateZoneJoystick(uint8_t exited, uint8_t entered)
+{
+    (void) exited;
+    Mobile_Joystick.background = JoystickBackgrounds[entered + 1 == MYSTERIOUSMINES ? JOYSTICK_BLUE : JOYSTICK_BLACK];
+}
+
+// Sets the zone Freddy is in and tells the listeners if it changed
+static void SetCurrentZone(uint8_t zone)
+{
+    if (zone == CurrentZone) return;
+
+    uint8_t exited = CurrentZone;
+    CurrentZone = zone;
+    for (uint8_t i = 0; i < AmountOfZoneListeners; i++) ZoneListeners[i](exited, zone);
+}
+
 void InitWorld(void)
 {
+    PROFILE_SCOPE("InitWorld");
+
     if (!CurrentWorld) LoadWorldTilemap();
 
+    // The theme, zone effect and joystick below are Fazbear Hills', so the next UpdateZone swaps them if Freddy is elsewhere
+    // (the listeners still hear about the reset so ones outside the world, like the battle background, don't keep the last zone)
+
+    CurrentZone = UNKNOWN_ZONE;
+    SubscribeZoneChange(UpdateZoneTheme);
+    SubscribeZoneChange(UpdateZoneEffect);
+    SubscribeZoneChange(UpdateZoneJoystick);
+    SetCurrentZone(FAZBEARHILLS - 1);
+
     // Temporary limits log level to minimize printing to console (for faster load times)
 
     //SetTraceLogLevel(LOG_WARNING);
 
-    SetWorldSpriteSheet("Assets/Overworld/Maps/Overworld/spritesheet.png", 50); 
+    {
+        PROFILE_SCOPE("InitWorld: SpriteSheet");
+
+        // A project loaded with LoadWorldProject brings its own spritesheets (its tile ids don't match this one's)
+
+        if (!WorldProjectLoaded)
+        {
+            SetWorldSpriteSheet("Assets/Overworld/maps/Overworld/spritesheet.png", 50); 
+            SetWorldTileFlags("Assets/Overworld/maps/Overworld/tiles.json");
+        }
+    }
 
     // Particles
 
@@ -507,36 +871,50 @@ void InitWorld(void)
     
     // Musics and Sounds
 
-    CurrentTheme = LoadMusicStream("Assets/Themes/fazbearhills.mp3");
-    CurrentTheme.looping = 1;
+    {
+        PROFILE_SCOPE("InitWorld: Audio");
 
-    PlayMusicStream(CurrentTheme);
+        CurrentTheme = LoadMusicStream("Assets/Themes/fazbearhills.mp3");
+        CurrentTheme.looping = 1;
 
-    WarpSoundEffect = LoadSound("Assets/Sound_Effects/Zone_Warping.wav");
+        PlayMusicStream(CurrentTheme);
+
+        WarpSoundEffect = LoadSound("Assets/Sound_Effects/Zone_Warping.wav");
+    }
 
     // Zone Effects
 
-    LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/sun_effect_mod.png", SKY_TINT);
-    SetTextureFilter(LegacyZoneEffect.texture, TEXTURE_FILTER_BILINEAR);
+    {
+        PROFILE_SCOPE("InitWorld: Zone Effects");
+
+        LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/sun_effect_mod.png", SKY_TINT);
+        SetTextureFilter(LegacyZoneEffect.texture, TEXTURE_FILTER_BILINEAR);
 
-    SunHeader = LoadTexture("Assets/Overworld/sun_effect_top.png");
-    SetTextureWrap(SunHeader, TEXTURE_WRAP_CLAMP);
-    SetTextureFilter(SunHeader, TEXTURE_FILTER_BILINEAR);
+        SunHeader = LoadTexture("Assets/Overworld/sun_effect_top.png");
+        SetTextureWrap(SunHeader, TEXTURE_WRAP_CLAMP);
+        SetTextureFilter(SunHeader, TEXTURE_FILTER_BILINEAR);
+    }
 
-    InitFreddy();
+    {
+        PROFILE_SCOPE("InitWorld: Entities");
 
-    // Initizing repeated UIVisuals
+        InitFreddy();
+        InitWorldObjects();
 
-    InitBuildings_Pre();
-    InitBuildings_After();
-    
-    
-    ItemAtlas = LoadTexture("Assets/Overworld/NPCs/items.png");
+        // Initizing repeated UIVisuals
+
+        InitBuildings();
+        
+        
+        ItemAtlas = LoadTexture("Assets/Overworld/NPCs/items.png");
+
+        InitZoneButtons();
+        InitJoystick();
+        InitMines();
+        InitBoxes();
+    }
 
-    InitZoneButtons();
-    InitJoystick();
-    InitMines();
-    InitBoxes();
+    PROFILE_SCOPE("InitWorld: UI");
 
     ZoneHeader[0] = LoadTexture("Assets/Overworld/UI/Zone_Names/1.png"); 
     ZoneHeader[1] = LoadTexture("Assets/Overworld/UI/Zone_Names/2.png"); 
@@ -547,7 +925,7 @@ void InitWorld(void)
                                         CreateUIElement(CreateUIVisual_UITexture_P("Assets/Overworld/UI/Zone_Buttons/1.png", 
                                                             WHITE), 
                                         0.90, -0.8, 1.5),
-                                        .press = WarpButton_1,
+                                        .press = WarpButtonPress,
                                         .hover=NULL, 
                                         0
                                     },
@@ -557,7 +935,7 @@ void InitWorld(void)
                                         CreateUIElement(CreateUIVisual_UITexture_P("Assets/Overworld/UI/Zone_Buttons/2.png", 
                                                             WHITE), 
                                         0.90, -0.6, 1.5),
-                                        .press = WarpButton_2,
+                                        .press = WarpButtonPress,
                                         .hover=NULL, 
                                         0
                                     },
@@ -567,7 +945,7 @@ void InitWorld(void)
                                         CreateUIElement(CreateUIVisual_UITexture_P("Assets/Overworld/UI/Zone_Buttons/3.png", 
                                                             WHITE), 
                                         0.90, -0.4, 1.5),
-                                        .press = WarpButton_3,
+                                        .press = WarpButtonPress,
                                         .hover=NULL, 
                                         0
                                     },
@@ -648,7 +1026,7 @@ static Vector2 GetEntityCorner(WORLDEntity * entity, enum Corner corner)
     }
 }
 
-static uint8_t CheckCollisionTilemap(WORLDEntity * entity, WORLDTilemapLayer * layer)
+uint8_t CheckCollisionTilemap(WORLDEntity * entity, WORLDTilemapLayer * layer)
 {
     if (!(entity -> collisionTargets & layer -> FLAGS)) return 0;
     
@@ -738,32 +1116,34 @@ static void HandleEntityCollision(WORLDEntity * entity)
 }
 
 // Updates velocity and collision of a WORLDEntity
-void UpdateWorldEntity(WORLDEntity * entity)
+// Returns 1 if the entity's hitbox overlaps a tile of a layer it collides with
+uint8_t CheckCollisionWorld(WORLDEntity * entity)
 {
-    if (entity -> velocity.x == 0 && entity -> velocity.y == 0) return;
-    entity -> position.x += entity -> velocity.x * GetFrameTime();
+    // LAYER_COLLIDABLE layers are merged into one bit-grid, so this doesn't depend on the amount of layers
 
-    for (uint16_t i = 1; i < CurrentWorld -> amount; i++)
-    {
-        uint8_t check = CheckCollisionTilemap(entity, &CurrentWorld->layers[i]);
-        if (check)
-        {
-            entity -> position.x -= entity -> velocity.x * GetFrameTime();
-            break;
-        }
-    }
+    if (entity -> collisionTargets & LAYER_COLLIDABLE && 
+        IsSolidInRect(CurrentWorld, floorf(entity -> position.x), floorf(entity -> position.y), 
+                      floorf(entity -> position.x + entity -> size.x), floorf(entity -> position.y + entity -> size.y))) return 1;
 
-    entity -> position.y += entity -> velocity.y * GetFrameTime();
+    if (!(entity -> collisionTargets & ~LAYER_COLLIDABLE)) return 0;
 
     for (uint16_t i = 1; i < CurrentWorld -> amount; i++)
     {
-        uint8_t check = CheckCollisionTilemap(entity, &CurrentWorld->layers[i]);
-        if (check)
-        {
-            entity -> position.y -= entity -> velocity.y * GetFrameTime();
-            break;
-        }
+        if (CheckCollisionTilemap(entity, &CurrentWorld->layers[i])) return 1;
     }
+    return 0;
+}
+
+void UpdateWorldEntity(WORLDEntity * entity)
+{
+    if (entity -> velocity.x == 0 && entity -> velocity.y == 0) return;
+    entity -> position.x += entity -> velocity.x * GetInputFrameTime();
+
+    if (CheckCollisionWorld(entity)) entity -> position.x -= entity -> velocity.x * GetInputFrameTime();
+
+    entity -> position.y += entity -> velocity.y * GetInputFrameTime();
+
+    if (CheckCollisionWorld(entity)) entity -> position.y -= entity -> velocity.y * GetInputFrameTime();
 }
 
 
@@ -836,6 +1216,8 @@ void RenderWorldEntity(WORLDEntity * entity)
             entity -> position.y + entity -> size.y < camera.y ||
             entity -> position.y > camera.y + camera.height) return;
     
+    VisibleWorldEntities++;
+
     // Rendering entity
 
     switch (entity-> visual -> type) {
@@ -932,7 +1314,7 @@ void SpawnBirds(void)
     static float wait = 2;
     uint8_t count = GetRandomValue(1,7);
     
-    if (clock() - timeSinceLastParticle > CLOCKS_PER_SEC * wait) 
+    if (Rayclock() - timeSinceLastParticle > CLOCKS_PER_SEC * wait) 
     {
         float degrees = 225/180.*PI;
         Vector2 start = (Vector2) {1, GetRandomValue(50, 150) / 100. - 1};
@@ -943,7 +1325,7 @@ void SpawnBirds(void)
         }
         CreateParticle(BirdParticle, start.x, start.y, cosf(degrees)/2.5, sinf(degrees)/2.5);
 
-        timeSinceLastParticle = clock();
+        timeSinceLastParticle = Rayclock();
         wait = GetRandomValue(50, 400) / 100.;
     }
 }
@@ -1024,24 +1406,36 @@ void RenderZoneEffect_Zone3(Vector2 offset)
 }
 
 
-// Gets the zone Freddy is currently in
+// Gets the zone Freddy is in (worked out once per tick, WORLDZONES - 1 or UNKNOWN_ZONE)
 uint8_t GetZone(void)
 {
-    static uint16_t ZoneIds[] = {32, 33, 46, 89};
-    Vector2 ZoneCheck = (Vector2) {Freddy.position.x + Freddy.size.x / 2, Freddy.position.y + Freddy.size.y / 2};
-
-    if (!CurrentWorld) return 0;
-
-    uint16_t Zone = AccessPositionInLayer((uint16_t) ZoneCheck.x, (uint16_t) ZoneCheck.y, CurrentWorld->layers + 0);
+    return CurrentZone;
+}
 
-    uint16_t i = 0;
+// Calls (listener) on every zone change from now on, returns 0 if there are already MAX_ZONE_LISTENERS
+_Bool SubscribeZoneChange(WORLDZoneListener listener)
+{
+    for (uint8_t i = 0; i < AmountOfZoneListeners; i++) if (ZoneListeners[i] == listener) return 1;
 
-    for (; i <= sizeof(ZoneIds) / 2; i++) 
+    if (AmountOfZoneListeners >= MAX_ZONE_LISTENERS)
     {
-        if (Zone == ZoneIds[i]) break;
+        printf("WORLD: Too many zone listeners!\n");
+        return 0;
     }
-    if (i == sizeof(ZoneIds) / 2) return 0xff;
-    return i;
+    ZoneListeners[AmountOfZoneListeners++] = listener;
+    return 1;
+}
+
+// Looks up the zone under the middle of Freddy's hitbox and tells the listeners if it changed
+static void UpdateZone(void)
+{
+    float x = floorf(Freddy.position.x + Freddy.size.x / 2);
+    float y = floorf(Freddy.position.y + Freddy.size.y / 2);
+
+    uint8_t zone = UNKNOWN_ZONE;
+    if (x >= 0 && y >= 0 && x < ZoneGridWidth && y < ZoneGridHeight) zone = ZoneGrid[(size_t) y * ZoneGridWidth + (size_t) x];
+
+    SetCurrentZone(zone);
 }
 
 void RenderZoneEffect(void)
@@ -1070,7 +1464,11 @@ void RenderZoneEffect(void)
 void RenderZoneName(void)
 {
     uint8_t zone = GetZone();
-    if (zone == 0xff) RenderUIText("Unknown Zone", -0.95, -0.9, 0.03, LEFTMOST, (Font) {0}, WHITE);
+    if (zone == UNKNOWN_ZONE)
+    {
+        RenderUIText("Unknown Zone", -0.95, -0.9, 0.03, LEFTMOST, (Font) {0}, WHITE);
+        return;
+    }
     float scale = (float) ZoneHeader[zone].height / GetScreenHeight();
     Color tint = WHITE;
     if (zone == 2 && DustingFieldsLogoIsBlack) tint = BLACK; 
@@ -1079,12 +1477,12 @@ void RenderZoneName(void)
 
 void RenderWorldButtons(void)
 {
-    for (uint8_t i = 2; i <= GetZone_Level() && i - 2 < NUMBER_OF_BUTTONS; i++)
+    for (uint16_t i = 0; i < AmountOfZoneButtons; i++)
     {
-        if (i - 2 == 1) continue;
-        WorldZoneButtonUpdater[i - 2].visual = &ButtonDown;
+        if (!WorldZoneButtonUpdater[i].visual) continue;
+        if (i + 2 <= GetZone_Level()) WorldZoneButtonUpdater[i].visual = &ButtonDown;
+        RenderWorldEntity(WorldZoneButtonUpdater + i);
     }
-    RenderWorldEntities(WorldZoneButtonUpdater, 0, IGNORE_DEPTH);
 }
 
 void RenderChipBoxes(WORLDBox * boxes, uint16_t amount)
@@ -1096,43 +1494,154 @@ void RenderChipBoxes(WORLDBox * boxes, uint16_t amount)
     }
 }
 
+// Draws one tile of the current spritesheets at a position on the Virtual Screen (in tiles)
+static inline void DrawWorldTile(WORLDTile id, uint32_t x, uint32_t y)
+{
+    // Ids past the end of the spritesheet have nothing to draw
+
+    if (id >= CurrentWorldTileset -> amount) return;
+    const WORLDTileInfo * tile = CurrentWorldTileset -> tiles + id;
+
+    DrawTexturePro( CurrentWorldPages[tile -> page], 
+                    (Rectangle) {tile -> sourceX, tile -> sourceY, CurrentTileSize, CurrentTileSize}, 
+                    (Rectangle) {x * CurrentTileSize, y * CurrentTileSize, CurrentTileSize, CurrentTileSize}, 
+                    (Vector2) {0,0}, 
+                    0, 
+                    WHITE);
+}
+
+// A tile waiting in the page batch of RenderLayer
+typedef struct WORLDPageTile
+{
+    WORLDTile id;
+    uint16_t x; // Position on the Virtual Screen (in tiles)
+    uint16_t y;
+} WORLDPageTile;
+
+static WORLDPageTile PageBatch[WORLD_PAGE_BATCH];
+static WORLDPageTile SortedPageBatch[WORLD_PAGE_BATCH];
+static uint16_t PageBatchSize = 0;
+static _Bool PageBatching = 1;
+
+// Turns the page batch of RenderLayer on / off (on by default, the tools turn it off to compare)
+void SetWorldPageBatching(_Bool enabled)
+{
+    PageBatching = enabled;
+}
+
+// Draws the tiles in the page batch one page after another (tiles of a layer never overlap, so their order doesn't matter)
+static void FlushPageBatch(void)
+{
+    uint16_t start[MAX_TILESET_PAGES + 1] = {0};
+
+    // Counting sort by page, the batch only holds ids inside the tileset
+
+    for (uint16_t i = 0; i < PageBatchSize; i++) start[CurrentWorldTileset -> tiles[PageBatch[i].id].page + 1]++;
+    for (uint8_t page = 1; page < MAX_TILESET_PAGES; page++) start[page] += start[page - 1];
+    for (uint16_t i = 0; i < PageBatchSize; i++) SortedPageBatch[start[CurrentWorldTileset -> tiles[PageBatch[i].id].page]++] = PageBatch[i];
+
+    for (uint16_t i = 0; i < PageBatchSize; i++) DrawWorldTile(SortedPageBatch[i].id, SortedPageBatch[i].x, SortedPageBatch[i].y);
+    PageBatchSize = 0;
+}
+
+// Draws a tile of a layer, with more than one page it goes through the page batch so the texture isn't switched per tile
+static inline void PutLayerTile(WORLDTile id, uint32_t x, uint32_t y)
+{
+    if (AmountOfWorldPages <= 1 || !PageBatching)
+    {
+        DrawWorldTile(id, x, y);
+        return;
+    }
+    if (id >= CurrentWorldTileset -> amount) return;
+
+    PageBatch[PageBatchSize++] = (WORLDPageTile) {id, x, y};
+    if (PageBatchSize == WORLD_PAGE_BATCH) FlushPageBatch();
+}
+
 // Renders WORLDTilemapLayer onto Virtual Screen
+// With more than one spritesheet page, the visible tiles are drawn page by page (up to WORLD_PAGE_BATCH tiles at a time)
 void RenderLayer(uint16_t n, Vector2 CameraMinorOffset)
 {
-    if (CurrentWorld -> layers[n].FLAGS & LAYER_INVISIBLE)
+    PROFILE_SCOPE("RenderLayer");
+
+    if (n >= CurrentWorld -> amount || CurrentWorld -> layers[n].FLAGS & LAYER_INVISIBLE || !CurrentWorldTileset)
     {
         return;
     } 
 
+    WORLDTilemapLayer * layer = CurrentWorld -> layers + n;
     Rectangle CameraView = GetCameraView();
-    
-    for (uint16_t y = (uint16_t) CameraView.y; y <= (uint16_t) CameraView.y + (uint16_t) CameraView.height + 1; y += 1)
+
+    uint32_t startX = (uint16_t) CameraView.x, endX = startX + (uint16_t) CameraView.width + 1;
+    uint32_t startY = (uint16_t) CameraView.y, endY = startY + (uint16_t) CameraView.height + 1;
+    if (endX > UINT16_MAX) endX = UINT16_MAX;
+    if (endY > UINT16_MAX) endY = UINT16_MAX;
+
+    // Goes through the row spans of the visible rows, empty tiles are never visited
+
+    for (uint32_t y = startY; y <= endY; y++)
     {
-        for (uint16_t x = (uint16_t) CameraView.x; x <= (uint16_t) CameraView.x + (uint16_t) CameraView.width + 1; x += 1)
+        uint32_t amount;
+        const WORLDTileSpan * spans = GetLayerVisibleRowSpans(layer, y, &amount);
+
+        // Finds the first span that isn't left of the view
+
+        uint32_t first = 0, last = amount;
+        while (first < last)
+        {
+            uint32_t middle = (first + last) / 2;
+            if ((uint32_t) spans[middle].start + spans[middle].length <= startX) first = middle + 1;
+            else last = middle;
+        }
+
+        for (uint32_t span = first; span < amount && spans[span].start <= endX; span++)
         {
-            uint16_t id = AccessPositionInLayer(x, y, CurrentWorld -> layers + n);
-            
-            if (!id) continue;
-            id--;
-            Rectangle sprite = {    (uint16_t) (id * CurrentTileSize) % CurrentWorldSpriteSheet.width, 
-                                    (uint16_t) (id * CurrentTileSize) / CurrentWorldSpriteSheet.width * CurrentTileSize,
-                                    CurrentTileSize,
-                                    CurrentTileSize};
-            Vector2 screen_pos = (Vector2) {(x - (uint16_t) CameraView.x) * CurrentTileSize, 
-                                            (y - (uint16_t) CameraView.y) * CurrentTileSize};
-            DrawTexturePro( CurrentWorldSpriteSheet, 
-                            sprite, 
-                            (Rectangle) {screen_pos.x, screen_pos.y, CurrentTileSize, CurrentTileSize}, 
-                            (Vector2) {0,0}, 
-                            0, 
-                            WHITE);
+            uint32_t fromX = spans[span].start > startX ? spans[span].start : startX;
+            uint32_t toX = (uint32_t) spans[span].start + spans[span].length - 1;
+            if (toX > endX) toX = endX;
+
+            // Specialised per layer encoding, the chunk is looked up again whenever a span crosses into the next one
+            // (spans from a .ywmap aren't checked against the chunks, so empty ones are skipped)
+
+            if (layer -> encoding == LAYER_ENCODING_PALETTE)
+            {
+                const uint8_t * chunk = NULL;
+                for (uint32_t x = fromX; x <= toX; x++)
+                {
+                    if (!chunk || !(x & (WORLD_CHUNK_SIZE - 1))) chunk = GetLayerPaletteChunk(layer, x >> WORLD_CHUNK_SHIFT, y >> WORLD_CHUNK_SHIFT);
+                    if (!chunk)
+                    {
+                        x |= WORLD_CHUNK_SIZE - 1;
+                        continue;
+                    }
+                    PutLayerTile(layer -> palette[chunk[(y & (WORLD_CHUNK_SIZE - 1)) * WORLD_CHUNK_SIZE + (x & (WORLD_CHUNK_SIZE - 1))]],
+                                 x - startX, y - startY);
+                }
+            }
+            else
+            {
+                const WORLDTile * chunk = NULL;
+                for (uint32_t x = fromX; x <= toX; x++)
+                {
+                    if (!chunk || !(x & (WORLD_CHUNK_SIZE - 1))) chunk = GetLayerChunk(layer, x >> WORLD_CHUNK_SHIFT, y >> WORLD_CHUNK_SHIFT);
+                    if (!chunk)
+                    {
+                        x |= WORLD_CHUNK_SIZE - 1;
+                        continue;
+                    }
+                    PutLayerTile(chunk[(y & (WORLD_CHUNK_SIZE - 1)) * WORLD_CHUNK_SIZE + (x & (WORLD_CHUNK_SIZE - 1))], x - startX, y - startY);
+                }
+            }
         }
     }
+    if (PageBatchSize) FlushPageBatch();
 }
 
 // Renders the entire overworld on-screen
 void RenderWorld(void)
 {
+    PROFILE_SCOPE("RenderWorld");
+
     float screenRatio = (float) GetScreenWidth() / GetScreenHeight();
 
     int vWidth = (WorldCamera.zoom * CurrentTileSize) * screenRatio + CurrentTileSize;
@@ -1149,6 +1658,8 @@ void RenderWorld(void)
 
     Rectangle CameraView = GetCameraView();
 
+    VisibleWorldEntities = 0;
+
     Vector2 CameraMinorOffset = (Vector2) { (float) (CameraView.x - (uint16_t) CameraView.x) * (GetScreenHeight() / WorldCamera.zoom),
                                             (float) (CameraView.y - (uint16_t) CameraView.y) * (GetScreenHeight() / WorldCamera.zoom)};
     BeginTextureMode(WorldVirtualScreen);
@@ -1163,17 +1674,15 @@ void RenderWorld(void)
 
         // Renders all WORLDEntities
 
-        RenderWorldEntities(Ent_MinesTeleporters, i, FAST);
-        RenderWorldEntities(Ex_MinesTeleporters, i, FAST);
+        RenderWorldEntities(Ent_MinesTeleporters, i, PROPER);
+        RenderWorldEntities(Ex_MinesTeleporters, i, PROPER);
         if (i == 2) RenderWorldButtons();
-        if (i == Freddy.depth) RenderChipBoxes(ChipBoxes, NUMBER_OF_CHIPS);
+        if (i == Freddy.depth) RenderChipBoxes(ChipBoxes, AmountOfChipBoxes);
         if (i == Freddy.depth) RenderWorldEntity(&Freddy);
 
         //if (i == WorldWheel.depth) RenderWorldEntity(&WorldWheel);
 
-        RenderWorldEntities(WorldBuildings_Pre, i, FAST);
-        
-        RenderWorldEntities(WorldBuildings_After, i, FAST);
+        RenderWorldEntities(WorldBuildings, i, PROPER);
     }
 
     // Renders current zone effect
@@ -1195,6 +1704,18 @@ void RenderWorld(void)
                     WHITE);
 }
 
+// Gets the amount of WORLDEntities that passed the camera culling in the last RenderWorld
+uint16_t GetVisibleWorldEntityCount(void)
+{
+    return VisibleWorldEntities;
+}
+
+// Gets the size of the render texture the overworld is drawn to before upscaling (0x0 before the first RenderWorld)
+Vector2 GetWorldVirtualScreenSize(void)
+{
+    return (Vector2) {WorldVirtualScreen.texture.width, WorldVirtualScreen.texture.height};
+}
+
 static float absf(float x)
 {
     *(int *)&x &= 0x7fffffff;
@@ -1203,18 +1724,20 @@ static float absf(float x)
 
 void UpdateFreddy(void)
 {
+    PROFILE_SCOPE("UpdateFreddy");
+
     static uint8_t lastDirection = 0;
 
     uint8_t CurrentDirection = 0;
 
     if (GetInputType() == KEYBOARD)
     {
-        if (IsKeyDown(KEY_W)) Freddy.velocity.y = -2, CurrentDirection = 1;
-        else if (IsKeyDown(KEY_S)) Freddy.velocity.y = 2, CurrentDirection = 4;
+        if (IsInputKeyDown(KEY_W)) Freddy.velocity.y = -2, CurrentDirection = 1;
+        else if (IsInputKeyDown(KEY_S)) Freddy.velocity.y = 2, CurrentDirection = 4;
         else Freddy.velocity.y = 0;
 
-        if (IsKeyDown(KEY_A)) Freddy.velocity.x = -2, CurrentDirection = 2;
-        else if (IsKeyDown(KEY_D)) Freddy.velocity.x = 2, CurrentDirection = 3;
+        if (IsInputKeyDown(KEY_A)) Freddy.velocity.x = -2, CurrentDirection = 2;
+        else if (IsInputKeyDown(KEY_D)) Freddy.velocity.x = 2, CurrentDirection = 3;
         else Freddy.velocity.x = 0;
     } else if (GetInputType() == TOUCH) {
         Freddy.velocity.x = Mobile_Joystick.velocity.x * 2;
@@ -1260,59 +1783,10 @@ void UpdateFreddy(void)
     WorldCamera.position = (Vector2) {Freddy.position.x + Freddy.size.x / 2, Freddy.position.y + Freddy.size.y / 2};
 }
 
-void UpdateZoneAssets(void)
-{
-    static enum WORLDZONES LastZoneCheck = 1;
-    
-    if (LastZoneCheck == GetZone() + 1) return;
-
-    if ((LastZoneCheck == FAZBEARHILLS || LastZoneCheck == CHOPPYSWOODS)
-         && (GetZone() + 1 == FAZBEARHILLS || GetZone() + 1 == CHOPPYSWOODS)) return;
-    
-    LastZoneCheck = GetZone() + 1;
-
-    UnloadMusicStream(CurrentTheme);
-    FreeUIVisual(&LegacyZoneEffect);
-
-    UnloadTexture(Mobile_Joystick.background);
-    
-    memset(&LegacyZoneEffect, 0, sizeof(UIVisual));
-    switch (LastZoneCheck) 
-    {
-        case DUSTINGFIELDS:
-            CurrentTheme = LoadMusicStream("Assets/Themes/dustingfields.mp3");
-            LegacyZoneEffect = CreateUIVisual_UIAnimation_V2(   "Assets/Overworld/Zone_Effects/dusting_fields_effect.png", 
-                                                                60, 11,
-                                                                (Vector2) {800, 480}, WHITE);
-            SetTextureFilter(LegacyZoneEffect.animation_V2.Atlas, TEXTURE_FILTER_BILINEAR);
-            Mobile_Joystick.background = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_black.png");
-            FlushParticles();
-            break;
-        case MYSTERIOUSMINES:
-            CurrentTheme = LoadMusicStream("Assets/Themes/mysteriousmines.mp3");
-            LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/mysterious_mines_effect.png", WHITE);
-            Mobile_Joystick.background = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_blue.png");
-            FlushParticles();
-            break;
-        case CHOPPYSWOODS:
-        case FAZBEARHILLS:
-        default:
-            CurrentTheme = LoadMusicStream("Assets/Themes/fazbearhills.mp3");
-            LegacyZoneEffect = CreateUIVisual_UITexture_P("Assets/Overworld/Zone_Effects/sun_effect_mod.png", SKY_TINT);
-            Mobile_Joystick.background = LoadTexture("Assets/Overworld/UI_Touch/joystick/backgrounds/joystick_background_black.png");
-            SetTextureFilter(LegacyZoneEffect.texture, TEXTURE_FILTER_BILINEAR);
-    }
-    
-    SetTextureFilter( Mobile_Joystick.background, TEXTURE_FILTER_BILINEAR);
-
-    CurrentTheme.looping = 1;
-    PlayMusicStream(CurrentTheme);
-}
-
 void PutZoneWarp(void)
 {
     JumpVisual.visual.tint = WHITE;
-    if (GetZone() + 1 == 2 && DustingFieldsLogoIsBlack) JumpVisual.visual.tint = BLACK; 
+    if (CurrentZone + 1 == CHOPPYSWOODS && DustingFieldsLogoIsBlack) JumpVisual.visual.tint = BLACK; 
     RenderUIElement(&JumpVisual);
     for (uint16_t i = 0; i < GetZone_Level(); i++)
     {
@@ -1419,13 +1893,13 @@ void UpdateJoystick(void)
 
     Vector2 velocity = {0};
 
-    if (IsKeyDown(KEY_A)) velocity.x = -1;
-    else if (IsKeyDown(KEY_D)) velocity.x = 1;
+    if (IsInputKeyDown(KEY_A)) velocity.x = -1;
+    else if (IsInputKeyDown(KEY_D)) velocity.x = 1;
 
-    if (IsKeyDown(KEY_W)) velocity.y = -1;
-    else if (IsKeyDown(KEY_S)) velocity.y = 1;
+    if (IsInputKeyDown(KEY_W)) velocity.y = -1;
+    else if (IsInputKeyDown(KEY_S)) velocity.y = 1;
 
-    if ((IsKeyDown(KEY_W) || IsKeyDown(KEY_S)) && (IsKeyDown(KEY_A) || IsKeyDown(KEY_D)))
+    if ((IsInputKeyDown(KEY_W) || IsInputKeyDown(KEY_S)) && (IsInputKeyDown(KEY_A) || IsInputKeyDown(KEY_D)))
     {
         Mobile_Joystick.velocity = velocity;
         return;
@@ -1521,7 +1995,7 @@ void PutDefaultUI(void)
 
 void HandleWorldButtonCollision(void)
 {
-    for (uint8_t i = GetZone_Level() - 1; i < NUMBER_OF_BUTTONS; i++)
+    for (uint16_t i = GetZone_Level() - 1; i < AmountOfZoneButtons; i++)
     {
         if (!CheckEntityCollision(WorldZoneButtonUpdater + i, &Freddy)) continue;
         SetZone_Level(i + 2);
@@ -1563,54 +2037,49 @@ void HandleBoxCollisions(WORLDBox * boxes, uint16_t amount)
     }
 }
 
-static void HandleMineCollision_Ent(void)
+// Takes Freddy to the payload position of the first mine entrance / exit he walks into
+static void HandleMineCollision_Group(const WORLDObjectGroup * group, WORLDEntity * entities)
 {
-    static Vector2 look_up_table[NUMBER_OF_MINES] = {   (Vector2) {29.15, 71.275},
-                                                        (Vector2) {36.15, 61.275}};
-    for (uint8_t i = 0; i < NUMBER_OF_MINES; i++)
+    if (!group || entities == NoWorldEntities) return;
+
+    for (uint32_t i = 0; i < group -> amount; i++)
     {
-        if (CheckEntityCollision(&Freddy, Ent_MinesTeleporters + i))
+        if (CheckEntityCollision(&Freddy, entities + i))
         {
-            Freddy.position = look_up_table[i];
-            WorldCamera.position = look_up_table[i];
+            Freddy.position = (Vector2) {group -> objects[i].payload[0], group -> objects[i].payload[1]};
+            WorldCamera.position = Freddy.position;
         }
     }
-
 }
 
-static void HandleMineCollision_Ex(void)
+static void HandleMineCollision(void)
 {
-    static Vector2 look_up_table[NUMBER_OF_MINES] = {   (Vector2) {44.65, 33},
-                                                        (Vector2) {8.65, 23}};
-    for (uint8_t i = 0; i < NUMBER_OF_MINES; i++)
-    {
-        if (CheckEntityCollision(&Freddy, Ex_MinesTeleporters + i))
-        {
-            Freddy.position = look_up_table[i];
-            WorldCamera.position = look_up_table[i];
-        }
-    }
-
+    HandleMineCollision_Group(MineEntrances, Ent_MinesTeleporters);
+    HandleMineCollision_Group(MineExits, Ex_MinesTeleporters);
 }
 
-static void HandleMineCollision(void)
+// Updates the overworld without rendering anything (also used by the headless world simulation)
+void UpdateWorld(void)
 {
-    HandleMineCollision_Ent();
-    HandleMineCollision_Ex();
+    PROFILE_SCOPE("UpdateWorld");
+
+    UpdateMusicStream(CurrentTheme);
+    UpdateFreddy();
+    HandleWorldButtonCollision();
+    HandleBoxCollisions(ChipBoxes, AmountOfChipBoxes);
+    HandleMineCollision();
+    UpdateZone();
+    //if (IsKeyPressed(KEY_F)) SwapGameState(Battle);
 }
 
 void PutWorld(void)
 {   
-    UpdateMusicStream(CurrentTheme);
-    UpdateFreddy();
-    UpdateZoneAssets();
+    PROFILE_SCOPE("PutWorld");
+
+    UpdateWorld();
     RenderWorld();
     PutUIParticles();
     RenderZoneName();
-    HandleWorldButtonCollision();
-    HandleBoxCollisions(ChipBoxes, NUMBER_OF_CHIPS);
-    HandleMineCollision();
-    //if (IsKeyPressed(KEY_F)) SwapGameState(Battle);
     PutDefaultUI();
     RenderChipNoteBanner();
 }
\ No newline at end of file
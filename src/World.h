@@ -35,8 +35,20 @@ enum WORLDZONES
     MYSTERIOUSMINES
 };
 
+// GetZone value for a tile that isn't in any zone
+#define UNKNOWN_ZONE 0xff
+
+#define MAX_ZONE_LISTENERS 16
+
+// Called once when Freddy leaves a zone and enters another (GetZone values, (exited) / (entered) can be UNKNOWN_ZONE)
+typedef void (*WORLDZoneListener)(uint8_t exited, uint8_t entered);
+
+// Gets the zone Freddy is in (worked out once per tick, WORLDZONES - 1 or UNKNOWN_ZONE)
 extern uint8_t GetZone(void);
 
+// Calls (listener) on every zone change from now on, returns 0 if there are already MAX_ZONE_LISTENERS
+extern _Bool SubscribeZoneChange(WORLDZoneListener listener);
+
 typedef UIVisual WORLDTileDefinition;
 
 typedef uint16_t WORLDTile;
@@ -61,8 +73,27 @@ typedef struct WORLDCamera
     float zoom; // The amount of tiles you can see on the Y axis
 } WORLDCamera;
 
+extern WORLDCamera WorldCamera;
+
 extern void LoadWorldTilemap(void);
 
+// Loads the overworld tilemap and spritesheets from a Spritefusion project file (sprite sheets embedded as base64 PNGs)
+// InitWorld keeps it instead of loading map.json and its spritesheet, returns 1 on success (0 leaves the overworld as it was)
+extern _Bool LoadWorldProject(const char * path);
+
+// Makes (tilemap) the overworld tilemap and returns the previous one, the caller owns both (used by the tools)
+extern WORLDTilemap * SwapWorldTilemap(WORLDTilemap * tilemap);
+
+// Adds another spritesheet to the overworld tileset as its next page, its tiles come after the ones already there
+// Returns the WORLDTile of its first tile (what the map's ids for it are offset by), 0 on failure
+extern WORLDTile AddWorldSpriteSheet(const char * path);
+
+// Turns the page batch of RenderLayer on / off (on by default, the tools turn it off to compare)
+extern void SetWorldPageBatching(_Bool enabled);
+
+// Sets the FLAGS of the current spritesheet's tiles from a tile metadata JSON (see LoadTilesetFlags)
+extern void SetWorldTileFlags(const char * path);
+
 #define ACCESS_TILEMAP(x, y, tilemap) 
 
 extern void InitWorld(void);
@@ -73,10 +104,27 @@ enum Corner
     TOPLEFT, TOPRIGHT, BOTTOMLEFT, BOTTONRIGHT
 };
 
+// Returns 1 if any corner of an entity's hitbox is on a tile in a layer it collides with
+extern uint8_t CheckCollisionTilemap(WORLDEntity * entity, WORLDTilemapLayer * layer);
+
+// Returns 1 if the entity's hitbox overlaps a tile of a layer it collides with
+extern uint8_t CheckCollisionWorld(WORLDEntity * entity);
+
 extern void UpdateWorldEntity(WORLDEntity * entity);
+extern void UpdateWorld(void);
 extern void RenderWorld(void);
+
+// Renders the tiles of layer (n) of the overworld tilemap that are in the camera view
+extern void RenderLayer(uint16_t n, Vector2 CameraMinorOffset);
+
 extern void PutWorld(void);
 
+// Gets the amount of WORLDEntities that passed the camera culling in the last RenderWorld
+extern uint16_t GetVisibleWorldEntityCount(void);
+
+// Gets the size of the render texture the overworld is drawn to before upscaling (0x0 before the first RenderWorld)
+extern Vector2 GetWorldVirtualScreenSize(void);
+
 typedef struct _WarpButton 
 {
     UIButton button;
@@ -22,6 +22,9 @@
 
 #include "World_Chip_Note.h"
 #include "UI.h"
+#include "Profiler.h"
+#define ASSET_SUBSYSTEM "World"
+#include "Asset_Tracker.h"
 #include <malloc.h>
 #include <stdint.h>
 #include <memory.h>
@@ -29,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "rayclock.h"
 
 #define MAX_CHIPS_IN_QUEUE 10
 #define CHIP_NOTE_SCREEN_TIME 2
@@ -117,12 +121,12 @@ void UpdateChipNoteBanner(void)
     {
         current_queue = GetUnavailableChipQueue();
         LoadNewChipBanner();
-        cooldown = clock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC;
+        cooldown = Rayclock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC;
         last_queue = wait_queue;
         return;
     }
     
-    if (clock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC - cooldown >= CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC)
+    if (Rayclock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC - cooldown >= CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC)
     {
         chip_queue[current_queue] = 0;
         wait_queue--;
@@ -137,7 +141,7 @@ void UpdateChipNoteBanner(void)
             return;
         }
         LoadNewChipBanner();
-        cooldown = clock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC;
+        cooldown = Rayclock() + CHIP_NOTE_SCREEN_TIME * CLOCKS_PER_SEC;
     }
     
     last_queue = wait_queue;
@@ -157,6 +161,7 @@ void PrintChipQueue(void)
 
 void RenderChipNoteBanner(void)
 {
+    PROFILE_SCOPE("RenderChipNoteBanner");
     UpdateChipNoteBanner();
     RenderUIElement(&current_chip_banner);
 }
\ No newline at end of file
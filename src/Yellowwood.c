@@ -22,35 +22,138 @@
     SOFTWARE.
 */
 
-#include "../Include/cJSON.h"
 #include "Yellowwood.h"
 #include <stdlib.h>
 #include <memory.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
 
+#ifdef _WIN32
+
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+
+#else
+
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+#endif
+
+#include "Alloc_Tracker.h"
+
+// Tiles a layer's intermediate tile buffer starts with (it doubles when it runs out)
+#define INITIAL_MAP_TILES 4096
+
+// Most threads a map JSON is decoded on (the calling thread included)
+#define MAX_MAP_LOAD_THREADS 8
+
+// Longest error message a layer can keep until it's printed
+#define MAP_ERROR_LENGTH 128
 
 _Bool EncounterError = 0;
 
-// The intermediate tile format used during the layer parsing process
-typedef struct intermediate_tile 
+// Potential error codes to be used in void ErrorEncountered(enum ErrorIDs id)
+enum ErrorIDs
+{
+    NOERRMESSAGE, BADPATH, BADOBJECT, FMALLOC, BTILE, BADJSON
+};
+
+// An error found while decoding, kept until the calling thread prints it (EncounterError is only set from there)
+typedef struct map_error
+{
+    _Bool failed;
+    enum ErrorIDs id;
+    size_t position; // Byte in the map text the reader stopped at
+    char message[MAP_ERROR_LENGTH]; // Printed instead of the position if it isn't empty
+} map_error;
+
+// The intermediate tile format used during the layer parsing process (project files use pixel positions which can be negative)
+typedef struct intermediate_tile
 {
-    uint16_t x;
-    uint16_t y;
+    int32_t x;
+    int32_t y;
     uint16_t textureID;
+    uint16_t spriteSheet; // Index in the map_reader sheets, NO_SPRITE_SHEET if the tile doesn't have a spriteSheetId
 } intermediate_tile;
 
-// Potential error codes to be used in void ErrorEncountered(enum ErrorIDs id)
-enum ErrorIDs
+#define NO_SPRITE_SHEET UINT16_MAX
+
+// A layer while it's decoded, every layer has its own tile buffer and error so layers can be decoded on different threads
+typedef struct intermediate_layer
 {
-    NOERRMESSAGE, BADPATH, BADOBJECT, FMALLOC, BTILE
-};
+    const char * json; // The layer object in the map text
+    const char * jsonEnd;
+
+    intermediate_tile * tiles;
+    uint32_t amountOfTiles;
+    uint32_t tilesCapacity;
+
+    int32_t minX;
+    int32_t minY;
+    int32_t maxX;
+    int32_t maxY;
+
+    uint8_t FLAGS;
+    _Bool project; // Has tiles with a spriteSheetId, tile positions are in pixels
+
+    const char * name; // Points into the map text, NULL if the layer doesn't have one
+    size_t nameLength;
+    _Bool hasCollider;
+
+    map_error error;
+} intermediate_layer;
+
+// A sprite sheet embedded in a project file while it's decoded, sheets are decoded on the same threads as the layers
+typedef struct intermediate_sheet
+{
+    const char * id; // Points into the map text
+    size_t idLength;
+    const char * data; // The data URI, points into the map text
+    size_t dataLength;
+
+    void * image; // What the WORLDSpriteSheetDecoder returned
+    map_error error;
+} intermediate_sheet;
+
+// Forward-only tokenizer state over a Spritefusion map JSON, only the tiles themselves are kept
+typedef struct map_reader
+{
+    const char * text;
+    const char * position;
+    const char * end;
+    map_error error;
+
+    int32_t tileSize;
+    int32_t mapWidth; // -1 if the map doesn't have one
+    int32_t mapHeight; // -1 if the map doesn't have one
+    _Bool project; // Spritefusion project file, tile positions are in pixels
+
+    intermediate_layer * layers;
+    uint16_t amountOfLayers;
+    uint16_t layersCapacity;
+
+    intermediate_sheet * sheets;
+    uint16_t amountOfSheets;
+    uint16_t sheetsCapacity;
+    uint16_t lastSheet; // Sheet of the last tile read, tiles next to each other tend to share one
+    WORLDSpriteSheetFree freeImage; // Frees the sheet images FreeMapReader finds, NULL if they aren't decoded
+} map_reader;
+
+// Compares a key read with ReadMapString to a string literal
+#define MAP_KEY_IS(key, length, literal) ((length) == sizeof(literal) - 1 && !memcmp(key, literal, sizeof(literal) - 1))
 
 // Prints error message and toggles EncounterError boolean
 void ErrorEncountered(enum ErrorIDs id)
 {
-    switch (id) 
+    switch (id)
     {
         case BADPATH:
             printf("Invalid JSON path!\n");
@@ -64,6 +167,9 @@ void ErrorEncountered(enum ErrorIDs id)
         case BTILE:
             printf("Invalid Spritefusion Tile JSON!\n");
             break;
+        case BADJSON:
+            printf("Invalid JSON syntax!\n");
+            break;
         case NOERRMESSAGE:
             break;
     }
@@ -73,166 +179,517 @@ void ErrorEncountered(enum ErrorIDs id)
 // Access a position in a WORLDTilemapLayer and returns a WORLDTile
 WORLDTile AccessPositionInLayer(uint16_t x, uint16_t y, WORLDTilemapLayer * layer)
 {
-    x -= layer -> offsetX;
+    uint16_t chunkX = (x >> WORLD_CHUNK_SHIFT) - layer -> chunkX;
+    uint16_t chunkY = (y >> WORLD_CHUNK_SHIFT) - layer -> chunkY;
+    if (chunkX >= layer -> chunksX || chunkY >= layer -> chunksY) return 0;
+
+    uint32_t chunk = layer -> chunkTable[chunkY * layer -> chunksX + chunkX];
+    if (!chunk) return 0;
+
+    size_t tile = (size_t) (chunk - 1) * WORLD_CHUNK_TILES + (y & (WORLD_CHUNK_SIZE - 1)) * WORLD_CHUNK_SIZE + (x & (WORLD_CHUNK_SIZE - 1));
+    return layer -> encoding == LAYER_ENCODING_PALETTE ? layer -> palette[layer -> indices[tile]] : layer -> tiles[tile];
+}
+
+// Returns the tiles of a chunk (WORLDTile[WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE]) by chunk position, NULL if it's empty
+// (or if the layer is a palette layer)
+WORLDTile * GetLayerChunk(const WORLDTilemapLayer * layer, uint16_t chunkX, uint16_t chunkY)
+{
+    chunkX -= layer -> chunkX;
+    chunkY -= layer -> chunkY;
+    if (chunkX >= layer -> chunksX || chunkY >= layer -> chunksY || !layer -> tiles) return NULL;
+
+    uint32_t chunk = layer -> chunkTable[chunkY * layer -> chunksX + chunkX];
+    return chunk ? layer -> tiles + (size_t) (chunk - 1) * WORLD_CHUNK_TILES : NULL;
+}
+
+// Returns the palette indices of a chunk (uint8_t[WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE]) by chunk position, NULL if it's empty
+// (or if the layer isn't a palette layer)
+uint8_t * GetLayerPaletteChunk(const WORLDTilemapLayer * layer, uint16_t chunkX, uint16_t chunkY)
+{
+    chunkX -= layer -> chunkX;
+    chunkY -= layer -> chunkY;
+    if (chunkX >= layer -> chunksX || chunkY >= layer -> chunksY || !layer -> indices) return NULL;
+
+    uint32_t chunk = layer -> chunkTable[chunkY * layer -> chunksX + chunkX];
+    return chunk ? layer -> indices + (size_t) (chunk - 1) * WORLD_CHUNK_TILES : NULL;
+}
+
+// Returns the spans of tiles in a row of a layer (Y is a tile position) and puts how many there are in (amount)
+const WORLDTileSpan * GetLayerRowSpans(const WORLDTilemapLayer * layer, uint16_t y, uint32_t * amount)
+{
     y -= layer -> offsetY;
-    if (x >= layer -> sizeX || y >= layer -> sizeY) return 0;
+    if (!layer -> rowSpans || y >= layer -> sizeY)
+    {
+        *amount = 0;
+        return NULL;
+    }
 
-    register WORLDTile (*tiles)[layer -> sizeY][layer -> sizeX] = layer -> tiles;
-    
-    return (*tiles)[y][x];
+    *amount = layer -> rowSpans[y + 1] - layer -> rowSpans[y];
+    return layer -> spans + layer -> rowSpans[y];
 }
 
-// Returns 1 if the base string starts with the substring. I.E base = "Hi There\0", substring = "Hi\0", result = 1
-uint8_t strstcmp(register const char * base, register const char * substring) {
-    register uint64_t i = 0;
-    while (base[i] == substring[i]) {
-        if (base[i] == '\0' || substring[i] == '\0') break;
-        i += 1;
+// Same as GetLayerRowSpans but without the tiles hidden by opaque tiles of lower layers (once BakeTileOcclusion ran)
+const WORLDTileSpan * GetLayerVisibleRowSpans(const WORLDTilemapLayer * layer, uint16_t y, uint32_t * amount)
+{
+    if (!layer -> visibleRowSpans) return GetLayerRowSpans(layer, y, amount);
+
+    y -= layer -> offsetY;
+    if (y >= layer -> sizeY)
+    {
+        *amount = 0;
+        return NULL;
     }
-    if (substring[i] == '\0') return 1;
+
+    *amount = layer -> visibleRowSpans[y + 1] - layer -> visibleRowSpans[y];
+    return layer -> visibleSpans + layer -> visibleRowSpans[y];
+}
+
+// Builds the row span index of a layer from its chunks, returns 0 if it couldn't be allocated
+static _Bool InitLayerSpans(WORLDTilemapLayer * layer)
+{
+    layer -> rowSpans = NULL;
+    layer -> spans = NULL;
+    if (!layer -> amountOfChunks) return 1;
+
+    uint32_t * rowSpans = malloc(sizeof(uint32_t) * (layer -> sizeY + 1));
+    WORLDTileSpan * spans = NULL;
+    if (!rowSpans) return 0;
+
+    // First pass counts the spans, the second one fills them in
+
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        uint32_t amount = 0;
+        uint32_t endX = (uint32_t) layer -> offsetX + layer -> sizeX;
+
+        for (uint32_t y = 0; y < layer -> sizeY; y++)
+        {
+            uint32_t row = layer -> offsetY + y;
+            uint32_t start = 0;
+            _Bool inSpan = 0;
+
+            rowSpans[y] = amount;
+
+            for (uint32_t x = layer -> offsetX; x < endX;)
+            {
+                // Whole empty chunks are skipped
+
+                const WORLDTile * chunk = GetLayerChunk(layer, x >> WORLD_CHUNK_SHIFT, row >> WORLD_CHUNK_SHIFT);
+                const uint8_t * paletteChunk = GetLayerPaletteChunk(layer, x >> WORLD_CHUNK_SHIFT, row >> WORLD_CHUNK_SHIFT);
+                uint32_t chunkEndX = ((x >> WORLD_CHUNK_SHIFT) + 1) << WORLD_CHUNK_SHIFT;
+                if (chunkEndX > endX) chunkEndX = endX;
+
+                for (; x < chunkEndX; x++)
+                {
+                    uint32_t i = (row & (WORLD_CHUNK_SIZE - 1)) * WORLD_CHUNK_SIZE + (x & (WORLD_CHUNK_SIZE - 1));
+                    _Bool tile = chunk ? chunk[i] != 0 : paletteChunk ? layer -> palette[paletteChunk[i]] != 0 : 0;
+                    if (tile == inSpan) continue;
+
+                    if (tile) start = x;
+                    else
+                    {
+                        if (pass) spans[amount] = (WORLDTileSpan) {start, x - start};
+                        amount++;
+                    }
+                    inSpan = tile;
+                }
+            }
+
+            if (inSpan)
+            {
+                if (pass) spans[amount] = (WORLDTileSpan) {start, endX - start};
+                amount++;
+            }
+        }
+
+        rowSpans[layer -> sizeY] = amount;
+
+        if (!pass)
+        {
+            spans = malloc(sizeof(WORLDTileSpan) * (amount ? amount : 1));
+            if (!spans)
+            {
+                free(rowSpans);
+                return 0;
+            }
+        }
+    }
+
+    layer -> rowSpans = rowSpans;
+    layer -> spans = spans;
+    return 1;
+}
+
+// Returns 1 if any tile of a spritesheet has every one of (flags)
+static _Bool TilesetHasFlags(const WORLDTileset * tileset, uint8_t flags)
+{
+    if (!tileset) return 0;
+    for (uint16_t i = 0; i < tileset -> amount; i++) if ((tileset -> tiles[i].FLAGS & flags) == flags) return 1;
     return 0;
 }
 
-// Checks if a layer has object (jsonFlag) and gets value, if 1, turns on (bitflag) at a WORLDTilemapLayer destination
-void InitLayerFlag(WORLDTilemapLayer * dest, const cJSON * layer, const char * jsonFlag, uint8_t bitflag)
+// Rebuilds the collision bit-grid from the LAYER_COLLIDABLE layers and the TILE_SOLID tiles of (tileset) (can be NULL)
+// Returns 0 if it couldn't be allocated
+_Bool BuildCollisionGrid(WORLDTilemap * tilemap, const WORLDTileset * tileset)
 {
-    uint8_t flag = bitflag;
+    free(tilemap -> collision);
+
+    // Without solid tiles only the collidable layers count
 
-    cJSON * object = cJSON_GetObjectItemCaseSensitive(layer, jsonFlag);
+    _Bool solidTiles = TilesetHasFlags(tileset, TILE_SOLID);
 
-    if (!object)
+    // The grid starts at tile 0, 0 and covers every layer that can collide
+
+    uint32_t width = 0, height = 0;
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
     {
-        printf("Invalid Layer Flag: \"%s\"!\n", jsonFlag);
-        return;
+        const WORLDTilemapLayer * layer = tilemap -> layers + i;
+        if ((!(layer -> FLAGS & LAYER_COLLIDABLE) && !solidTiles) || !layer -> amountOfChunks) continue;
+        if (width < (uint32_t) layer -> offsetX + layer -> sizeX) width = layer -> offsetX + layer -> sizeX;
+        if (height < (uint32_t) layer -> offsetY + layer -> sizeY) height = layer -> offsetY + layer -> sizeY;
     }
-    flag *= object -> valueint;
-    cJSON_free(object);
-    dest -> FLAGS |= flag;
+
+    tilemap -> collisionWidth = width;
+    tilemap -> collisionHeight = height;
+    tilemap -> collisionWords = (width + 63) / 64;
+    tilemap -> collision = NULL;
+    if (!width || !height) return 1;
+
+    tilemap -> collision = calloc((size_t) tilemap -> collisionWords * height, sizeof(uint64_t));
+    if (!tilemap -> collision) return 0;
+
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        WORLDTilemapLayer * layer = tilemap -> layers + i;
+        _Bool collidable = layer -> FLAGS & LAYER_COLLIDABLE;
+        if (!collidable && !solidTiles) continue;
+
+        // Only the tiles in the row spans need to be looked at
+
+        for (uint32_t y = layer -> offsetY; y < (uint32_t) layer -> offsetY + layer -> sizeY; y++)
+        {
+            uint32_t amount;
+            const WORLDTileSpan * spans = GetLayerRowSpans(layer, y, &amount);
+            uint64_t * row = tilemap -> collision + (size_t) y * tilemap -> collisionWords;
+
+            for (uint32_t span = 0; span < amount; span++)
+            {
+                for (uint32_t x = spans[span].start; x < (uint32_t) spans[span].start + spans[span].length; x++)
+                {
+                    if (!collidable)
+                    {
+                        WORLDTile tile = AccessPositionInLayer(x, y, layer);
+                        if (tile >= tileset -> amount || !(tileset -> tiles[tile].FLAGS & TILE_SOLID)) continue;
+                    }
+                    row[x >> 6] |= 1ull << (x & 63);
+                }
+            }
+        }
+    }
+    return 1;
 }
 
-// Checks if the name of a layer starts with (jsonFlag), if so, turns on (bitflag) at a WORLDTilemapLayer destination
-void InitLayerFlagFromName(WORLDTilemapLayer * dest, const cJSON * layer, const char * jsonFlag, uint8_t bitflag)
+// Builds the visible row spans of a layer from its row spans and a coverage bit-grid, returns 0 if it couldn't be allocated
+static _Bool InitLayerVisibleSpans(WORLDTilemapLayer * layer, const uint64_t * covered, uint32_t words)
 {
-    uint8_t flag = bitflag;
+    uint32_t * rowSpans = malloc(sizeof(uint32_t) * (layer -> sizeY + 1));
+    WORLDTileSpan * spans = NULL;
+    if (!rowSpans) return 0;
 
-    cJSON * object = cJSON_GetObjectItemCaseSensitive(layer, "name");
+    // First pass counts the spans, the second one fills them in
 
-    if (!object)
+    for (uint8_t pass = 0; pass < 2; pass++)
     {
-        printf("Invalid Layer, no name: \"%s\"!\n", jsonFlag);
-        return;
+        uint32_t amount = 0;
+
+        for (uint32_t y = 0; y < layer -> sizeY; y++)
+        {
+            const uint64_t * row = covered + (size_t) (layer -> offsetY + y) * words;
+            uint32_t amountOfSpans;
+            const WORLDTileSpan * tileSpans = GetLayerRowSpans(layer, layer -> offsetY + y, &amountOfSpans);
+
+            rowSpans[y] = amount;
+
+            // Every span gets split wherever it's covered
+
+            for (uint32_t span = 0; span < amountOfSpans; span++)
+            {
+                uint32_t endX = (uint32_t) tileSpans[span].start + tileSpans[span].length;
+                uint32_t start = 0;
+                _Bool inSpan = 0;
+
+                for (uint32_t x = tileSpans[span].start; x < endX; x++)
+                {
+                    _Bool visible = !(row[x >> 6] >> (x & 63) & 1);
+                    if (visible == inSpan) continue;
+
+                    if (visible) start = x;
+                    else
+                    {
+                        if (pass) spans[amount] = (WORLDTileSpan) {start, x - start};
+                        amount++;
+                    }
+                    inSpan = visible;
+                }
+
+                if (inSpan)
+                {
+                    if (pass) spans[amount] = (WORLDTileSpan) {start, endX - start};
+                    amount++;
+                }
+            }
+        }
+
+        rowSpans[layer -> sizeY] = amount;
+
+        if (!pass)
+        {
+            spans = malloc(sizeof(WORLDTileSpan) * (amount ? amount : 1));
+            if (!spans)
+            {
+                free(rowSpans);
+                return 0;
+            }
+        }
     }
-    flag *= strstcmp(object -> valuestring, jsonFlag);
-    if (flag) printf("Layer %s Is %s\n", object->valuestring, jsonFlag);
-    cJSON_free(object);
-    dest -> FLAGS |= flag;
+
+    layer -> visibleRowSpans = rowSpans;
+    layer -> visibleSpans = spans;
+    return 1;
 }
 
-// Returns the cJSON of a path
-cJSON * InitWorldJSON(const char * path)
+// Rebuilds the visible row spans of every layer from the TILE_OPAQUE tiles of (tileset) (lower layers are drawn on top)
+// Returns 0 if it couldn't be allocated (the layers then draw all of their tiles)
+_Bool BakeTileOcclusion(WORLDTilemap * tilemap, const WORLDTileset * tileset)
 {
-    FILE * jsonFile = fopen(path, "r"); // Opens JSON file
-    if (!jsonFile) 
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
     {
-        ErrorEncountered(BADPATH); 
-        return NULL;
+        free(tilemap -> layers[i].visibleRowSpans);
+        free(tilemap -> layers[i].visibleSpans);
+        tilemap -> layers[i].visibleRowSpans = NULL;
+        tilemap -> layers[i].visibleSpans = NULL;
     }
 
-    // Getting file size
+    // Without opaque tiles nothing can be hidden
 
-    fseek(jsonFile, 0L, SEEK_END);
-    size_t jsonTextLength = ftell(jsonFile);
-    rewind(jsonFile);
+    if (!TilesetHasFlags(tileset, TILE_OPAQUE)) return 1;
 
-    // Creating copy in heap
-    char * jsonText = malloc(jsonTextLength);
-    if (!jsonText) ErrorEncountered(FMALLOC);
-    fread(jsonText, 1, jsonTextLength, jsonFile);
-    fclose(jsonFile);
+    // 1 bit per tile, set wherever a drawn layer has an opaque tile (starts at tile 0, 0 like the collision grid)
 
-    // Parses tilemap json
+    uint32_t width = 0, height = 0;
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        const WORLDTilemapLayer * layer = tilemap -> layers + i;
+        if (layer -> FLAGS & LAYER_INVISIBLE || !layer -> rowSpans) continue;
+        if (width < (uint32_t) layer -> offsetX + layer -> sizeX) width = layer -> offsetX + layer -> sizeX;
+        if (height < (uint32_t) layer -> offsetY + layer -> sizeY) height = layer -> offsetY + layer -> sizeY;
+    }
 
-    cJSON * jsonParsed =  cJSON_Parse(jsonText);
+    uint32_t words = (width + 63) / 64;
+    if (!words || !height) return 1;
 
-    free(jsonText);
-    cJSON_Print(jsonParsed);
-    return jsonParsed;
-}
+    uint64_t * covered = calloc((size_t) words * height, sizeof(uint64_t));
+    if (!covered) return 0;
 
-// Gets number of layers in a Spritefusion map JSON
-uint32_t GetWorldLayers(const cJSON * json)
-{
-    cJSON * layers = cJSON_GetObjectItemCaseSensitive(json,"layers"); 
-    uint32_t numberOfLayer = cJSON_GetArraySize(layers);
-    cJSON_free(layers);
-    return numberOfLayer;
+    // Layer 0 is drawn last, so it's the only one that can't be covered
+
+    _Bool success = 1;
+    for (uint16_t i = 0; i < tilemap -> amount && success; i++)
+    {
+        WORLDTilemapLayer * layer = tilemap -> layers + i;
+        if (layer -> FLAGS & LAYER_INVISIBLE || !layer -> rowSpans) continue;
+
+        success = InitLayerVisibleSpans(layer, covered, words);
+
+        // A layer's own tiles don't hide each other, so they're only added once it's done
+
+        for (uint32_t y = layer -> offsetY; y < (uint32_t) layer -> offsetY + layer -> sizeY; y++)
+        {
+            uint32_t amount;
+            const WORLDTileSpan * spans = GetLayerRowSpans(layer, y, &amount);
+            uint64_t * row = covered + (size_t) y * words;
+
+            for (uint32_t span = 0; span < amount; span++)
+            {
+                for (uint32_t x = spans[span].start; x < (uint32_t) spans[span].start + spans[span].length; x++)
+                {
+                    WORLDTile tile = AccessPositionInLayer(x, y, layer);
+                    if (tile < tileset -> amount && tileset -> tiles[tile].FLAGS & TILE_OPAQUE) row[x >> 6] |= 1ull << (x & 63);
+                }
+            }
+        }
+    }
+
+    free(covered);
+    return success;
 }
 
-// Converts a string to a unsigned 32-bit integer
-uint32_t strtou32(char * str)
+// Returns 1 if the collision bit-grid is set anywhere in the rect (tile positions, inclusive, can be outside the map)
+_Bool IsSolidInRect(const WORLDTilemap * tilemap, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
-    uint32_t u32 = 0;
-    while (*str >= '0' && *str <= '9') u32 *= 10, u32 += *str - '0', str++;
-    return u32;
+    // Outside the grid there's nothing to collide with
+
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= tilemap -> collisionWidth) x1 = tilemap -> collisionWidth - 1;
+    if (y1 >= tilemap -> collisionHeight) y1 = tilemap -> collisionHeight - 1;
+    if (x0 > x1 || y0 > y1) return 0;
+
+    // Masks for the first and last word of each row, the words between are tested whole
+
+    uint32_t firstWord = x0 >> 6, lastWord = x1 >> 6;
+    uint64_t firstMask = ~0ull << (x0 & 63);
+    uint64_t lastMask = ~0ull >> (63 - (x1 & 63));
+    if (firstWord == lastWord) firstMask &= lastMask;
+
+    for (int32_t y = y0; y <= y1; y++)
+    {
+        const uint64_t * row = tilemap -> collision + (size_t) y * tilemap -> collisionWords;
+        if (row[firstWord] & firstMask) return 1;
+        if (firstWord == lastWord) continue;
+        for (uint32_t word = firstWord + 1; word < lastWord; word++) if (row[word]) return 1;
+        if (row[lastWord] & lastMask) return 1;
+    }
+    return 0;
 }
 
-// Parses a Spritefusion tile JSON and converts it to an intermediate_tile
-intermediate_tile ParseJSONTile(const cJSON * tileJSON)
+// Walks the collision bit-grid along a ray cell by cell (DDA) and puts the first solid cell in (hit), returns hit -> hit
+// Outside the grid there's nothing to hit, rays starting outside it are moved onto it first
+_Bool CastTileRay(const WORLDTilemap * tilemap, const WORLDRay * ray, WORLDRayHit * hit)
 {
-    // Gets all tile JSON parameters
+    *hit = (WORLDRayHit) {ray -> maxDistance > 0 ? ray -> maxDistance : 0, -1, -1, 0, 0};
 
-    cJSON * jsonID = cJSON_GetObjectItemCaseSensitive(tileJSON, "id");
-    cJSON * jsonX = cJSON_GetObjectItemCaseSensitive(tileJSON, "x");
-    cJSON * jsonY = cJSON_GetObjectItemCaseSensitive(tileJSON, "y");
+    float length = sqrtf(ray -> directionX * ray -> directionX + ray -> directionY * ray -> directionY);
+    if (!tilemap -> collision || !(length > 0) || !(ray -> maxDistance >= 0)) return 0;
 
-    // Checks if parameters are valid
+    float directionX = ray -> directionX / length, directionY = ray -> directionY / length;
+    float width = tilemap -> collisionWidth, height = tilemap -> collisionHeight;
 
-    if (jsonID == NULL)
-    {   
-        ErrorEncountered(BTILE);
-        return (intermediate_tile) {0};
-    }
-    
-    if (!jsonX)
+    // Clips the ray to the grid (slab test), so the walk never leaves it and never starts outside it
+
+    float enter = 0, leave = ray -> maxDistance;
+    uint8_t side = 0;
+    if (directionX)
     {
-        ErrorEncountered(BTILE);
-        return (intermediate_tile) {0};
+        float near = ((directionX > 0 ? 0 : width) - ray -> originX) / directionX;
+        float far = ((directionX > 0 ? width : 0) - ray -> originX) / directionX;
+        if (near > enter) enter = near;
+        if (far < leave) leave = far;
     }
+    else if (ray -> originX < 0 || ray -> originX >= width) return 0;
 
-    if (!jsonY)
+    if (directionY)
     {
-        ErrorEncountered(BTILE);
-        return (intermediate_tile) {0};
+        float near = ((directionY > 0 ? 0 : height) - ray -> originY) / directionY;
+        float far = ((directionY > 0 ? height : 0) - ray -> originY) / directionY;
+        if (near > enter)
+        {
+            enter = near;
+            side = 1;
+        }
+        if (far < leave) leave = far;
     }
+    else if (ray -> originY < 0 || ray -> originY >= height) return 0;
+
+    if (enter > leave || (enter == leave && enter > 0)) return 0;
+
+    // Starting cell, clamped since the entry point can land a rounding error off the grid
+
+    int32_t cellX = floorf(ray -> originX + directionX * enter), cellY = floorf(ray -> originY + directionY * enter);
+    if (cellX < 0) cellX = 0;
+    if (cellX >= tilemap -> collisionWidth) cellX = tilemap -> collisionWidth - 1;
+    if (cellY < 0) cellY = 0;
+    if (cellY >= tilemap -> collisionHeight) cellY = tilemap -> collisionHeight - 1;
 
-    // Gets parameters values
+    // Distances along the ray to the next vertical / horizontal cell edge and between two of them
 
-    char * stringID = cJSON_GetStringValue(jsonID);
-    uint32_t textureID = strtou32(stringID);
-    uint16_t x = jsonX -> valueint;
-    uint16_t y = jsonY -> valueint;
+    int32_t stepX = directionX > 0 ? 1 : -1, stepY = directionY > 0 ? 1 : -1;
+    float deltaX = directionX ? fabsf(1 / directionX) : INFINITY, deltaY = directionY ? fabsf(1 / directionY) : INFINITY;
+    float nextX = directionX ? (cellX + (directionX > 0) - ray -> originX) / directionX : INFINITY;
+    float nextY = directionY ? (cellY + (directionY > 0) - ray -> originY) / directionY : INFINITY;
 
-    // Frees JSON objects
+    float distance = enter;
+    uint16_t words = tilemap -> collisionWords;
+    for (;;)
+    {
+        if (tilemap -> collision[(size_t) cellY * words + (cellX >> 6)] >> (cellX & 63) & 1)
+        {
+            *hit = (WORLDRayHit) {distance, cellX, cellY, 1, side};
+            return 1;
+        }
+
+        if (nextX < nextY)
+        {
+            distance = nextX;
+            nextX += deltaX;
+            cellX += stepX;
+            side = 0;
+        }
+        else
+        {
+            distance = nextY;
+            nextY += deltaY;
+            cellY += stepY;
+            side = 1;
+        }
+
+        if (distance >= leave || cellX < 0 || cellX >= tilemap -> collisionWidth || cellY < 0 || cellY >= tilemap -> collisionHeight)
+        {
+            return 0;
+        }
+    }
+}
+
+// Casts (amount) rays, hits[i] is the result of rays[i], returns how many of them hit something
+// Rays with nearby origins should be next to each other so the grid rows they walk stay in cache
+uint32_t CastTileRays(const WORLDTilemap * tilemap, const WORLDRay * rays, WORLDRayHit * hits, uint32_t amount)
+{
+    uint32_t amountHit = 0;
+    for (uint32_t i = 0; i < amount; i++) amountHit += CastTileRay(tilemap, rays + i, hits + i);
+    return amountHit;
+}
 
-    cJSON_free(jsonID);
-    cJSON_free(jsonX);
-    cJSON_free(jsonY);
+// Returns 1 if no solid cell is between two positions (in tiles, the cells of both ends included)
+_Bool HasLineOfSight(const WORLDTilemap * tilemap, float fromX, float fromY, float toX, float toY)
+{
+    WORLDRay ray = {fromX, fromY, toX - fromX, toY - fromY, sqrtf((toX - fromX) * (toX - fromX) + (toY - fromY) * (toY - fromY))};
+    WORLDRayHit hit;
 
-    // Returns intermediate tile
+    // Both ends at the same point, only its cell can be in the way
 
-    return (intermediate_tile) {x, y, textureID};
+    if (!(ray.maxDistance > 0)) return !IsSolidInRect(tilemap, floorf(fromX), floorf(fromY), floorf(fromX), floorf(fromY));
+    return !CastTileRay(tilemap, &ray, &hit);
 }
 
-// Prints an intermediate_tile
-void PrintIntermediateTile(intermediate_tile tile)
+// Gets how many bytes the tiles of a tilemap take up (chunks, chunk tables and row spans)
+size_t GetTilemapTileBytes(const WORLDTilemap * tilemap)
 {
-    printf("X = %u, Y = %u, ID = %u\n", tile.x, tile.y, tile.textureID);
+    size_t bytes = 0;
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        const WORLDTilemapLayer * layer = tilemap -> layers + i;
+        bytes += (size_t) layer -> chunksX * layer -> chunksY * sizeof(uint32_t);
+        if (layer -> amountOfChunks) bytes += LAYER_CHUNK_BYTES(layer -> amountOfChunks, layer -> encoding);
+        if (layer -> rowSpans) bytes += (layer -> sizeY + 1) * sizeof(uint32_t) + layer -> rowSpans[layer -> sizeY] * sizeof(WORLDTileSpan);
+        if (layer -> visibleRowSpans) bytes += (layer -> sizeY + 1) * sizeof(uint32_t) + layer -> visibleRowSpans[layer -> sizeY] * sizeof(WORLDTileSpan);
+    }
+    return bytes;
+}
+
+// Returns 1 if the base string starts with the substring. I.E base = "Hi There\0", substring = "Hi\0", result = 1
+uint8_t strstcmp(register const char * base, register const char * substring) {
+    register uint64_t i = 0;
+    while (base[i] == substring[i]) {
+        if (base[i] == '\0' || substring[i] == '\0') break;
+        i += 1;
+    }
+    if (substring[i] == '\0') return 1;
+    return 0;
 }
 
 // Prints a WORLDTilemapLayer (for debugging)
 void PrintLayer(WORLDTilemapLayer * layer)
 {
-    register WORLDTile (*tiles)[layer -> sizeY][layer -> sizeX] = layer -> tiles;
     for (uint16_t y = 0; y < layer->sizeY; y++) {
         for (uint16_t x = 0; x < layer->sizeX; x++)
         {
@@ -244,151 +701,1772 @@ void PrintLayer(WORLDTilemapLayer * layer)
     printf("\n\n");
 }
 
-// Parses a Spritefusion layer JSON to a WORLDTilemapLayer destination
-void InitTitlemapLayer(WORLDTilemapLayer * dest, const cJSON * layerJSON)
+// Reads a whole file into a null-terminated heap buffer, returns NULL on failure
+static char * ReadMapFile(const char * path, size_t * length)
 {
-    // Getting tile array
-
-    cJSON * tiles = cJSON_GetObjectItemCaseSensitive(layerJSON, "tiles");
-    if (!tiles)
+    FILE * file = fopen(path, "rb");
+    if (!file)
     {
-        ErrorEncountered(BADOBJECT);
-        return;
-    } 
+        ErrorEncountered(BADPATH);
+        return NULL;
+    }
+
+    // Getting file size
+
+    fseek(file, 0L, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
 
-    // Creating variables
+    char * text = size >= 0 ? malloc((size_t) size + 1) : NULL;
+    if (!text)
+    {
+        ErrorEncountered(FMALLOC);
+        fclose(file);
+        return NULL;
+    }
+    *length = fread(text, 1, size, file);
+    text[*length] = '\0';
+    fclose(file);
+    return text;
+}
 
-    uint32_t AmountOfTiles = cJSON_GetArraySize(tiles);
+// Stops the reader and remembers where in the file it stopped
+static void MapReaderFailed(map_reader * reader, enum ErrorIDs id)
+{
+    if (reader -> error.failed) return;
+    reader -> error.failed = 1;
+    reader -> error.id = id;
+    reader -> error.position = reader -> position - reader -> text;
+}
 
-    uint16_t OffsetX = UINT16_MAX;
-    uint16_t OffsetY = UINT16_MAX;
+// Prints a map_error and toggles EncounterError, only called from the thread that loads the map
+static void ReportMapError(const map_error * error)
+{
+    if (!error -> failed) return;
+    if (error -> message[0]) printf("%s", error -> message);
+    else printf("Map JSON stopped parsing at byte %llu: ", (unsigned long long) error -> position);
+    ErrorEncountered(error -> id);
+}
 
-    uint16_t SizeX = 0;
-    uint16_t SizeY = 0;
+// Skips whitespace and returns the next character without consuming it ('\0' at the end of the text)
+static char PeekMapToken(map_reader * reader)
+{
+    while (reader -> position < reader -> end &&
+          (*reader -> position == ' ' || *reader -> position == '\n' || *reader -> position == '\r' || *reader -> position == '\t'))
+        reader -> position++;
+    return reader -> position < reader -> end ? *reader -> position : '\0';
+}
 
-    intermediate_tile * intermediate_tiles = malloc(sizeof(intermediate_tile) * AmountOfTiles);
-    if (!intermediate_tiles)
+// Consumes (token) or fails if it isn't next
+static void ExpectMapToken(map_reader * reader, char token)
+{
+    if (PeekMapToken(reader) != token)
     {
-        ErrorEncountered(FMALLOC);
-    } 
+        MapReaderFailed(reader, BADJSON);
+        return;
+    }
+    reader -> position++;
+}
 
-    // Getting layer dimensions
+// Consumes (open), returns 1 if the object / array is empty (also consuming (close)) or the reader failed
+static _Bool IsMapContainerEmpty(map_reader * reader, char open, char close)
+{
+    ExpectMapToken(reader, open);
+    if (reader -> error.failed) return 1;
+    if (PeekMapToken(reader) != close) return 0;
+    reader -> position++;
+    return 1;
+}
+
+// After a member / element, returns 1 if there's another one and 0 once the object / array is closed with (close)
+static _Bool NextMapMember(map_reader * reader, char close)
+{
+    char token = PeekMapToken(reader);
+    if (token == ',' || token == close) reader -> position++;
+    else MapReaderFailed(reader, BADJSON);
+    return token == ',' && !reader -> error.failed;
+}
 
-    for (uint16_t i = 0; i < AmountOfTiles; i++)
+// Reads a string, (string) and (length) point into the map text (escape sequences are left as they are)
+static void ReadMapString(map_reader * reader, const char ** string, size_t * length)
+{
+    *string = NULL;
+    *length = 0;
+
+    ExpectMapToken(reader, '"');
+    if (reader -> error.failed) return;
+
+    const char * quote = reader -> position;
+    while (1)
     {
-        cJSON * TileJSON = cJSON_GetArrayItem(tiles, i);
-        intermediate_tiles[i] = ParseJSONTile(TileJSON);
-        //cJSON_free(TileJSON); Off due to freeing crash possibility (not sure why)
+        quote = memchr(quote, '"', reader -> end - quote);
+        if (!quote)
+        {
+            MapReaderFailed(reader, BADJSON);
+            return;
+        }
 
-        if (OffsetX > intermediate_tiles[i].x) OffsetX = intermediate_tiles[i].x;
-        if (SizeX < intermediate_tiles[i].x) SizeX = intermediate_tiles[i].x;
+        // A quote is only escaped if there's an odd amount of backslashes before it
 
-        if (OffsetY > intermediate_tiles[i].y) OffsetY = intermediate_tiles[i].y;
-        if (SizeY < intermediate_tiles[i].y) SizeY = intermediate_tiles[i].y;
+        const char * backslash = quote;
+        while (backslash > reader -> position && backslash[-1] == '\\') backslash--;
+        if ((quote - backslash) % 2 == 0) break;
+        quote++;
     }
 
-    if (EncounterError) return;
+    *string = reader -> position;
+    *length = quote - reader -> position;
+    reader -> position = quote + 1;
+}
+
+// Reads an object key and the colon after it
+static void ReadMapKey(map_reader * reader, const char ** key, size_t * length)
+{
+    ReadMapString(reader, key, length);
+    ExpectMapToken(reader, ':');
+}
+
+// Skips any JSON value (strings are skipped with memchr so the base64 sprite sheets in project files don't cost much)
+static void SkipMapValue(map_reader * reader)
+{
+    uint32_t depth = 0;
+    const char * string;
+    size_t length;
 
-    // Offseting size
+    do
+    {
+        switch (PeekMapToken(reader))
+        {
+            case '"':
+                ReadMapString(reader, &string, &length);
+                break;
+            case '{':
+            case '[':
+                depth++;
+                reader -> position++;
+                break;
+            case '}':
+            case ']':
+            case ',':
+            case ':':
+                if (!depth)
+                {
+                    MapReaderFailed(reader, BADJSON);
+                    return;
+                }
+                depth -= *reader -> position == '}' || *reader -> position == ']';
+                reader -> position++;
+                break;
+            case '\0':
+                MapReaderFailed(reader, BADJSON);
+                return;
+            default:
+                // Numbers, true, false and null
+
+                while (reader -> position < reader -> end && *reader -> position != ',' && *reader -> position != '}' &&
+                       *reader -> position != ']' && *reader -> position != ' ' && *reader -> position != '\n' &&
+                       *reader -> position != '\r' && *reader -> position != '\t')
+                    reader -> position++;
+                break;
+        }
+    } while (depth && !reader -> error.failed);
+}
 
-    SizeX -= OffsetX - 1;
-    SizeY -= OffsetY - 1;
+// Reads a number (the fraction is cut off), a boolean or a string starting with a number (Spritefusion tile ids)
+static int32_t ReadMapInteger(map_reader * reader)
+{
+    char token = PeekMapToken(reader);
+    int32_t value = 0;
 
-    // Creating 2D Map array
+    if (token == '"')
+    {
+        const char * string;
+        size_t length;
+        ReadMapString(reader, &string, &length);
 
-    WORLDTile (*map)[SizeY][SizeX] = malloc(sizeof(WORLDTile) * SizeX * SizeY);
-    memset(map, 0, sizeof(WORLDTile) * SizeX * SizeY);
+        for (size_t i = 0; i < length && string[i] >= '0' && string[i] <= '9' && value < INT32_MAX / 10; i++)
+            value = value * 10 + (string[i] - '0');
+        return value;
+    }
 
-    if (!map) 
+    if (token == 't' || token == 'f')
     {
-        printf("Failed to allocate %lluB in heap!", sizeof(WORLDTile) * SizeX * SizeY);
-        ErrorEncountered(NOERRMESSAGE);
-        return;
+        SkipMapValue(reader);
+        return token == 't';
     }
 
-    // Filling map array
+    _Bool negative = token == '-';
+    reader -> position += negative;
 
-    for (uint16_t i = 0; i < AmountOfTiles; i++)
+    if (*reader -> position < '0' || *reader -> position > '9')
     {
-        (*map)[intermediate_tiles[i].y - OffsetY][intermediate_tiles[i].x - OffsetX] = intermediate_tiles[i].textureID + 1;
+        MapReaderFailed(reader, BADJSON);
+        return 0;
     }
 
-    cJSON_free(tiles);
+    while (*reader -> position >= '0' && *reader -> position <= '9')
+    {
+        if (value < INT32_MAX / 10) value = value * 10 + (*reader -> position - '0');
+        reader -> position++;
+    }
 
-    // Setting flags
+    // Fraction and exponent
 
-    dest -> tiles = map;
-    dest -> offsetX = OffsetX;
-    dest -> offsetY = OffsetY;
-    dest -> sizeX = SizeX;
-    dest -> sizeY = SizeY;
-    dest ->  FLAGS = 0;
-    InitLayerFlag(dest, layerJSON, "collider", LAYER_COLLIDABLE);
-    InitLayerFlagFromName(dest, layerJSON, "inv_", LAYER_INVISIBLE);
-        
+    while ((*reader -> position >= '0' && *reader -> position <= '9') || *reader -> position == '.' ||
+            *reader -> position == 'e' || *reader -> position == 'E' || *reader -> position == '+' || *reader -> position == '-')
+        reader -> position++;
+
+    return negative ? -value : value;
 }
 
-// Returns the address of a parsed tilemap based on a Spritefusion map JSON
-WORLDTilemap * CreateTilemap(const char * jsonPath)
+// Reads a spriteSheetId and returns the index of the sheet it refers to
+static uint16_t ReadMapSpriteSheetId(map_reader * reader)
 {
-    // Resets Error Detection
-
-    EncounterError = 0;
+    const char * id;
+    size_t length;
+    ReadMapString(reader, &id, &length);
+    if (reader -> error.failed) return NO_SPRITE_SHEET;
 
-    // Gets main cJSON object
+    for (uint16_t i = 0; i < reader -> amountOfSheets; i++)
+    {
+        const intermediate_sheet * sheet = reader -> sheets + (uint16_t) (reader -> lastSheet + i) % reader -> amountOfSheets;
+        if (sheet -> idLength == length && !memcmp(sheet -> id, id, length))
+        {
+            reader -> lastSheet = sheet - reader -> sheets;
+            return reader -> lastSheet;
+        }
+    }
 
-    cJSON * MainJSON = InitWorldJSON(jsonPath);
+    MapReaderFailed(reader, NOERRMESSAGE);
+    snprintf(reader -> error.message, MAP_ERROR_LENGTH, "Invalid spriteSheetId \"%.*s\"!\n", length < 64 ? (int) length : 64, id);
+    return NO_SPRITE_SHEET;
+}
 
-    if (!MainJSON)
+// Parses a Spritefusion tile JSON into the tile buffer of its layer and grows the bounds of the layer
+static void ParseMapTile(map_reader * reader, intermediate_layer * layer)
+{
+    if (layer -> amountOfTiles == layer -> tilesCapacity)
     {
-        printf("Invalid Path \"%s\"!\n", jsonPath);
-        ErrorEncountered(NOERRMESSAGE);
-        return NULL;
+        uint32_t capacity = layer -> tilesCapacity ? layer -> tilesCapacity * 2 : INITIAL_MAP_TILES;
+        intermediate_tile * tiles = capacity > layer -> tilesCapacity ? realloc(layer -> tiles, sizeof(intermediate_tile) * capacity) : NULL;
+        if (!tiles)
+        {
+            MapReaderFailed(reader, FMALLOC);
+            return;
+        }
+        layer -> tiles = tiles;
+        layer -> tilesCapacity = capacity;
     }
-    
-    // Gets layer JSON
 
-    cJSON * LayersJSON = cJSON_GetObjectItemCaseSensitive(MainJSON, "layers");
+    intermediate_tile * tile = layer -> tiles + layer -> amountOfTiles;
+    _Bool hasID = 0, hasX = 0, hasY = 0;
+    tile -> spriteSheet = NO_SPRITE_SHEET;
 
-    if (!LayersJSON)
+    if (IsMapContainerEmpty(reader, '{', '}'))
     {
-        printf("Invalid Spritefusion map (couldn't find layer JSON)!\n");
-        ErrorEncountered(NOERRMESSAGE);
-        return NULL;
+        MapReaderFailed(reader, BTILE);
+        return;
     }
 
-    // Gets map size to be potentially used for camera collisions (with the void)
+    do
+    {
+        const char * key;
+        size_t length;
+        ReadMapKey(reader, &key, &length);
+        if (reader -> error.failed) return;
+
+        if (MAP_KEY_IS(key, length, "id")) tile -> textureID = ReadMapInteger(reader), hasID = 1;
+        else if (MAP_KEY_IS(key, length, "x")) tile -> x = ReadMapInteger(reader), hasX = 1;
+        else if (MAP_KEY_IS(key, length, "y")) tile -> y = ReadMapInteger(reader), hasY = 1;
+        else if (MAP_KEY_IS(key, length, "spriteSheetId"))
+        {
+            layer -> project = 1;
+            tile -> spriteSheet = ReadMapSpriteSheetId(reader);
+        }
+        else SkipMapValue(reader);
+    } while (NextMapMember(reader, '}'));
+
+    if (reader -> error.failed) return;
+
+    // Checks if parameters are valid
 
-    cJSON * SizeXJSON = cJSON_GetObjectItemCaseSensitive(MainJSON, "mapWidth");
-    cJSON * SizeYJSON = cJSON_GetObjectItemCaseSensitive(MainJSON, "mapHeight");
+    if (!hasID || !hasX || !hasY)
+    {
+        MapReaderFailed(reader, BTILE);
+        return;
+    }
 
-    uint16_t mapWidth = SizeXJSON ? SizeXJSON -> valueint : UINT16_MAX;
-    uint16_t mapHeight = SizeYJSON ? SizeYJSON -> valueint : UINT16_MAX;
+    if (layer -> minX > tile -> x) layer -> minX = tile -> x;
+    if (layer -> maxX < tile -> x) layer -> maxX = tile -> x;
 
-    uint16_t AmountOfLayers = cJSON_GetArraySize(LayersJSON);
+    if (layer -> minY > tile -> y) layer -> minY = tile -> y;
+    if (layer -> maxY < tile -> y) layer -> maxY = tile -> y;
 
-    // Allocates tilemap struct and layer memory
+    layer -> amountOfTiles++;
+}
 
-    WORLDTilemap * tilemap = malloc(sizeof(WORLDTilemap));
-    tilemap -> layers = malloc(sizeof(WORLDTilemapLayer) * AmountOfLayers);
-    tilemap -> amount = AmountOfLayers;
-    tilemap -> mapWidth = mapWidth;
-    tilemap -> mapHeight = mapHeight;
-    
-    // Gets if the layer object exists to test map JSON valitidy
+// Parses a Spritefusion layer JSON into an intermediate_layer (messages about its flags are printed later by PrintMapLayerWarnings)
+static void ParseMapLayer(map_reader * reader, intermediate_layer * layer)
+{
+    _Bool hasTiles = 0;
 
-    if (LayersJSON == NULL)
+    if (IsMapContainerEmpty(reader, '{', '}'))
     {
-        printf("Invalid Map JSON \"%s\"!\n", jsonPath);
-        ErrorEncountered(NOERRMESSAGE);
-        return NULL;
+        MapReaderFailed(reader, BADOBJECT);
+        return;
     }
 
-    // Parses all layers and converts them to 2D uint16_t arrays
-    for (uint16_t i = 0; i < AmountOfLayers; i++)
+    do
     {
-        InitTitlemapLayer(tilemap -> layers + i, cJSON_GetArrayItem(LayersJSON,i));
-        if (EncounterError) return NULL;
-    }
-    return tilemap;
-}
\ No newline at end of file
+        const char * key;
+        size_t length;
+        ReadMapKey(reader, &key, &length);
+        if (reader -> error.failed) return;
+
+        if (MAP_KEY_IS(key, length, "name")) ReadMapString(reader, &layer -> name, &layer -> nameLength);
+        else if (MAP_KEY_IS(key, length, "collider"))
+        {
+            if (ReadMapInteger(reader)) layer -> FLAGS |= LAYER_COLLIDABLE;
+            layer -> hasCollider = 1;
+        }
+        else if (MAP_KEY_IS(key, length, "tiles"))
+        {
+            // Tiles are parsed straight into the tile buffer of the layer, there's no array of tile objects
+
+            hasTiles = 1;
+            if (!IsMapContainerEmpty(reader, '[', ']'))
+                do ParseMapTile(reader, layer); while (!reader -> error.failed && NextMapMember(reader, ']'));
+        }
+        else SkipMapValue(reader);
+    } while (!reader -> error.failed && NextMapMember(reader, '}'));
+
+    if (reader -> error.failed) return;
+
+    if (!hasTiles)
+    {
+        MapReaderFailed(reader, BADOBJECT);
+        return;
+    }
+
+    // Setting flags
+
+    if (layer -> name && layer -> nameLength >= 4 && !memcmp(layer -> name, "inv_", 4)) layer -> FLAGS |= LAYER_INVISIBLE;
+}
+
+// Prints the messages about a parsed layer's flags
+static void PrintMapLayerWarnings(const intermediate_layer * layer)
+{
+    if (!layer -> hasCollider) printf("Invalid Layer Flag: \"%s\"!\n", "collider");
+
+    if (!layer -> name) printf("Invalid Layer, no name: \"%s\"!\n", "inv_");
+    else if (layer -> FLAGS & LAYER_INVISIBLE) printf("Layer %.*s Is %s\n", (int) layer -> nameLength, layer -> name, "inv_");
+}
+
+// Parses the root object of a Spritefusion map JSON (map export or project file), layers are only found here and parsed later
+static void ParseMap(map_reader * reader)
+{
+    if (IsMapContainerEmpty(reader, '{', '}')) return;
+
+    do
+    {
+        const char * key;
+        size_t length;
+        ReadMapKey(reader, &key, &length);
+        if (reader -> error.failed) return;
+
+        if (MAP_KEY_IS(key, length, "tileSize")) reader -> tileSize = ReadMapInteger(reader);
+        else if (MAP_KEY_IS(key, length, "mapWidth")) reader -> mapWidth = ReadMapInteger(reader);
+        else if (MAP_KEY_IS(key, length, "mapHeight")) reader -> mapHeight = ReadMapInteger(reader);
+        else if (MAP_KEY_IS(key, length, "layers"))
+        {
+            if (IsMapContainerEmpty(reader, '[', ']')) continue;
+
+            do
+            {
+                if (reader -> amountOfLayers == UINT16_MAX)
+                {
+                    MapReaderFailed(reader, BADOBJECT);
+                    return;
+                }
+
+                if (reader -> amountOfLayers == reader -> layersCapacity)
+                {
+                    uint16_t capacity = reader -> layersCapacity ? reader -> layersCapacity * 2 : 16;
+                    if (capacity < reader -> layersCapacity) capacity = UINT16_MAX;
+                    intermediate_layer * layers = realloc(reader -> layers, sizeof(intermediate_layer) * capacity);
+                    if (!layers)
+                    {
+                        MapReaderFailed(reader, FMALLOC);
+                        return;
+                    }
+                    reader -> layers = layers;
+                    reader -> layersCapacity = capacity;
+                }
+
+                // Only the span of the layer object is kept, skipping it is a lot cheaper than parsing its tiles
+
+                intermediate_layer * layer = reader -> layers + reader -> amountOfLayers++;
+                *layer = (intermediate_layer) {.minX = INT32_MAX, .minY = INT32_MAX, .maxX = INT32_MIN, .maxY = INT32_MIN};
+
+                PeekMapToken(reader);
+                layer -> json = reader -> position;
+                SkipMapValue(reader);
+                layer -> jsonEnd = reader -> position;
+            } while (!reader -> error.failed && NextMapMember(reader, ']'));
+        }
+        else if (MAP_KEY_IS(key, length, "spriteSheets"))
+        {
+            // Project files only, {"id": "data:image/png;base64,...", ...}
+
+            if (IsMapContainerEmpty(reader, '{', '}')) continue;
+
+            do
+            {
+                if (reader -> amountOfSheets == UINT16_MAX - 1)
+                {
+                    MapReaderFailed(reader, BADOBJECT);
+                    return;
+                }
+
+                if (reader -> amountOfSheets == reader -> sheetsCapacity)
+                {
+                    uint16_t capacity = reader -> sheetsCapacity ? reader -> sheetsCapacity * 2 : 16;
+                    if (capacity < reader -> sheetsCapacity) capacity = UINT16_MAX - 1;
+                    intermediate_sheet * sheets = realloc(reader -> sheets, sizeof(intermediate_sheet) * capacity);
+                    if (!sheets)
+                    {
+                        MapReaderFailed(reader, FMALLOC);
+                        return;
+                    }
+                    reader -> sheets = sheets;
+                    reader -> sheetsCapacity = capacity;
+                }
+
+                intermediate_sheet * sheet = reader -> sheets + reader -> amountOfSheets++;
+                *sheet = (intermediate_sheet) {0};
+                ReadMapKey(reader, &sheet -> id, &sheet -> idLength);
+                ReadMapString(reader, &sheet -> data, &sheet -> dataLength);
+            } while (!reader -> error.failed && NextMapMember(reader, '}'));
+        }
+        else SkipMapValue(reader);
+    } while (!reader -> error.failed && NextMapMember(reader, '}'));
+}
+
+// Frees the tile buffers of every layer, the layers themselves and the sheets (their images too unless they were taken)
+static void FreeMapReader(map_reader * reader)
+{
+    for (uint16_t i = 0; i < reader -> amountOfLayers; i++) free(reader -> layers[i].tiles);
+    for (uint16_t i = 0; i < reader -> amountOfSheets; i++) if (reader -> freeImage && reader -> sheets[i].image) reader -> freeImage(reader -> sheets[i].image);
+    free(reader -> layers);
+    free(reader -> sheets);
+    reader -> layers = NULL;
+    reader -> amountOfLayers = 0;
+    reader -> sheets = NULL;
+    reader -> amountOfSheets = 0;
+}
+
+// Returns the value of a base64 digit, -1 if it isn't one
+static int8_t Base64Value(char digit)
+{
+    if (digit >= 'A' && digit <= 'Z') return digit - 'A';
+    if (digit >= 'a' && digit <= 'z') return digit - 'a' + 26;
+    if (digit >= '0' && digit <= '9') return digit - '0' + 52;
+    if (digit == '+') return 62;
+    if (digit == '/') return 63;
+    return -1;
+}
+
+// Decodes base64 into (output) (at least length / 4 * 3 bytes), stops at the padding and skips the backslashes of JSON escaped slashes
+// Returns the amount of bytes decoded, 0 if there's something that isn't base64
+static size_t DecodeBase64(const char * text, size_t length, unsigned char * output)
+{
+    uint32_t bits = 0;
+    uint8_t amountOfBits = 0;
+    size_t size = 0;
+
+    for (size_t i = 0; i < length && text[i] != '='; i++)
+    {
+        if (text[i] == '\\') continue;
+
+        int8_t value = Base64Value(text[i]);
+        if (value < 0) return 0;
+
+        bits = bits << 6 | value;
+        amountOfBits += 6;
+        if (amountOfBits >= 8)
+        {
+            amountOfBits -= 8;
+            output[size++] = bits >> amountOfBits;
+        }
+    }
+    return size;
+}
+
+// Decodes a sprite sheet's data URI and hands the file to (decoder), errors are kept in the sheet so it can run on any thread
+static void DecodeMapSpriteSheet(intermediate_sheet * sheet, WORLDSpriteSheetDecoder decoder)
+{
+    const char * comma = memchr(sheet -> data, ',', sheet -> dataLength);
+    unsigned char * file = NULL;
+    size_t size = 0;
+
+    if (comma && comma - sheet -> data >= 7 && !memcmp(comma - 7, ";base64", 7))
+    {
+        size_t length = sheet -> dataLength - (comma + 1 - sheet -> data);
+        file = malloc(length / 4 * 3 + 3);
+        if (file) size = DecodeBase64(comma + 1, length, file);
+    }
+
+    if (size) sheet -> image = decoder(file, size);
+    free(file);
+
+    if (!sheet -> image)
+    {
+        snprintf(sheet -> error.message, MAP_ERROR_LENGTH, "Invalid sprite sheet \"%.*s\"!\n",
+                 sheet -> idLength < 64 ? (int) sheet -> idLength : 64, sheet -> id);
+        sheet -> error.id = NOERRMESSAGE;
+        sheet -> error.failed = 1;
+    }
+}
+
+// Gives every (sprite sheet, tile) pair used in a project file its own WORLDTile, in sheet order and then tile order, and
+// rewrites the tiles to them, (sheets) gets which pair each WORLDTile is if it isn't NULL. Returns 0 on failure
+static _Bool RemapSpriteSheetTiles(map_reader * reader, WORLDSpriteSheets * sheets)
+{
+    // Every sheet gets room for its highest tile in the remap table
+
+    uint32_t * first = calloc(reader -> amountOfSheets + 1, sizeof(uint32_t));
+    if (!first)
+    {
+        ErrorEncountered(FMALLOC);
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < reader -> amountOfLayers; i++)
+    {
+        const intermediate_layer * layer = reader -> layers + i;
+        for (uint32_t tile = 0; tile < layer -> amountOfTiles; tile++)
+        {
+            uint16_t sheet = layer -> tiles[tile].spriteSheet;
+            if (sheet == NO_SPRITE_SHEET)
+            {
+                printf("Invalid Spritefusion project (a tile has no spriteSheetId)!\n");
+                ErrorEncountered(NOERRMESSAGE);
+                free(first);
+                return 0;
+            }
+            if (first[sheet + 1] <= layer -> tiles[tile].textureID) first[sheet + 1] = layer -> tiles[tile].textureID + 1;
+        }
+    }
+    for (uint16_t i = 0; i < reader -> amountOfSheets; i++) first[i + 1] += first[i];
+
+    uint16_t * remap = calloc(first[reader -> amountOfSheets] ? first[reader -> amountOfSheets] : 1, sizeof(uint16_t));
+    if (!remap)
+    {
+        ErrorEncountered(FMALLOC);
+        free(first);
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < reader -> amountOfLayers; i++)
+    {
+        const intermediate_layer * layer = reader -> layers + i;
+        for (uint32_t tile = 0; tile < layer -> amountOfTiles; tile++) remap[first[layer -> tiles[tile].spriteSheet] + layer -> tiles[tile].textureID] = 1;
+    }
+
+    uint32_t amountOfTiles = 0;
+    for (uint32_t i = 0; i < first[reader -> amountOfSheets]; i++) amountOfTiles += remap[i];
+
+    // textureID + 1 is the WORLDTile, so the highest textureID is UINT16_MAX - 1
+
+    WORLDSheetTile * tiles = amountOfTiles < UINT16_MAX && sheets ? malloc(sizeof(WORLDSheetTile) * (amountOfTiles + 1)) : NULL;
+    if (amountOfTiles >= UINT16_MAX || (sheets && !tiles))
+    {
+        if (amountOfTiles >= UINT16_MAX) printf("Invalid Spritefusion project (%u different tiles)!\n", amountOfTiles);
+        ErrorEncountered(amountOfTiles >= UINT16_MAX ? NOERRMESSAGE : FMALLOC);
+        free(remap);
+        free(first);
+        return 0;
+    }
+
+    if (tiles) tiles[0] = (WORLDSheetTile) {0, 0};
+    uint16_t amount = 0;
+    for (uint16_t sheet = 0; sheet < reader -> amountOfSheets; sheet++)
+    {
+        for (uint32_t i = first[sheet]; i < first[sheet + 1]; i++)
+        {
+            if (!remap[i]) continue;
+            remap[i] = ++amount;
+            if (tiles) tiles[amount] = (WORLDSheetTile) {sheet, i - first[sheet]};
+        }
+    }
+
+    for (uint16_t i = 0; i < reader -> amountOfLayers; i++)
+    {
+        intermediate_layer * layer = reader -> layers + i;
+        for (uint32_t tile = 0; tile < layer -> amountOfTiles; tile++)
+            layer -> tiles[tile].textureID = remap[first[layer -> tiles[tile].spriteSheet] + layer -> tiles[tile].textureID] - 1;
+    }
+
+    if (sheets)
+    {
+        sheets -> tiles = tiles;
+        sheets -> amountOfTiles = amount;
+    }
+    free(remap);
+    free(first);
+    return 1;
+}
+
+// Divides rounding towards negative infinity (pixel positions to tile positions)
+static int32_t FloorDivide(int32_t value, int32_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-(int64_t) value + divisor - 1) / divisor);
+}
+
+// Creates a WORLDTilemapLayer destination from an intermediate_layer, (shiftX) / (shiftY) are subtracted from every tile position
+// Errors are kept in the intermediate_layer so it can run on any thread
+static void InitTitlemapLayer(WORLDTilemapLayer * dest, intermediate_layer * layer, const map_reader * reader,
+                              int32_t shiftX, int32_t shiftY)
+{
+    dest -> FLAGS = layer -> FLAGS;
+    if (!layer -> amountOfTiles) return;
+
+    // Getting layer dimensions
+
+    int32_t minX = layer -> minX, maxX = layer -> maxX;
+    int32_t minY = layer -> minY, maxY = layer -> maxY;
+
+    if (reader -> project)
+    {
+        minX = FloorDivide(minX, reader -> tileSize), maxX = FloorDivide(maxX, reader -> tileSize);
+        minY = FloorDivide(minY, reader -> tileSize), maxY = FloorDivide(maxY, reader -> tileSize);
+    }
+
+    int64_t OffsetX = (int64_t) minX - shiftX;
+    int64_t OffsetY = (int64_t) minY - shiftY;
+    int64_t SizeX = (int64_t) maxX - minX + 1;
+    int64_t SizeY = (int64_t) maxY - minY + 1;
+
+    if (OffsetX < 0 || OffsetY < 0 || OffsetX + SizeX > UINT16_MAX || OffsetY + SizeY > UINT16_MAX)
+    {
+        snprintf(layer -> error.message, MAP_ERROR_LENGTH, "Layer tiles out of range (%lld, %lld to %lld, %lld)!\n",
+                 (long long) OffsetX, (long long) OffsetY, (long long) (OffsetX + SizeX - 1), (long long) (OffsetY + SizeY - 1));
+        layer -> error.id = BTILE;
+        layer -> error.failed = 1;
+        return;
+    }
+
+    uint16_t chunkX = OffsetX >> WORLD_CHUNK_SHIFT;
+    uint16_t chunkY = OffsetY >> WORLD_CHUNK_SHIFT;
+    uint16_t chunksX = ((OffsetX + SizeX - 1) >> WORLD_CHUNK_SHIFT) - chunkX + 1;
+    uint16_t chunksY = ((OffsetY + SizeY - 1) >> WORLD_CHUNK_SHIFT) - chunkY + 1;
+
+    uint32_t * chunkTable = calloc((size_t) chunksX * chunksY, sizeof(uint32_t));
+    if (!chunkTable)
+    {
+        snprintf(layer -> error.message, MAP_ERROR_LENGTH, "Failed to allocate %lluB in heap!\n",
+                 (unsigned long long) (sizeof(uint32_t) * chunksX * chunksY));
+        layer -> error.id = NOERRMESSAGE;
+        layer -> error.failed = 1;
+        return;
+    }
+
+    // Marks which chunks have tiles, then numbers them in row order so chunks next to each other stay close in memory
+
+    const intermediate_tile * tiles = layer -> tiles;
+    for (uint32_t i = 0; i < layer -> amountOfTiles; i++)
+    {
+        int32_t x = (reader -> project ? FloorDivide(tiles[i].x, reader -> tileSize) : tiles[i].x) - shiftX;
+        int32_t y = (reader -> project ? FloorDivide(tiles[i].y, reader -> tileSize) : tiles[i].y) - shiftY;
+        chunkTable[((y >> WORLD_CHUNK_SHIFT) - chunkY) * chunksX + (x >> WORLD_CHUNK_SHIFT) - chunkX] = 1;
+    }
+
+    uint32_t amountOfChunks = 0;
+    for (uint32_t i = 0; i < (uint32_t) chunksX * chunksY; i++) if (chunkTable[i]) chunkTable[i] = ++amountOfChunks;
+
+    // Picks the encoding, layers with few different tiles get a palette (index 0 stays the empty tile)
+
+    WORLDTile palette[LAYER_PALETTE_SIZE] = {0};
+    uint16_t paletteSize = 1;
+    uint8_t * remap = calloc(UINT16_MAX + 1, sizeof(uint8_t)); // WORLDTile -> palette index, 0 if it isn't in the palette yet
+
+    for (uint32_t i = 0; remap && i < layer -> amountOfTiles; i++)
+    {
+        WORLDTile tile = tiles[i].textureID + 1;
+        if (remap[tile]) continue;
+
+        if (paletteSize == LAYER_PALETTE_SIZE)
+        {
+            free(remap);
+            remap = NULL;
+            break;
+        }
+        palette[paletteSize] = tile;
+        remap[tile] = paletteSize++;
+    }
+
+    uint8_t encoding = remap ? LAYER_ENCODING_PALETTE : LAYER_ENCODING_WIDE;
+
+    // Creating chunks
+
+    size_t chunkBytes = LAYER_CHUNK_BYTES(amountOfChunks, encoding);
+    uint8_t * chunks = calloc(chunkBytes, 1);
+
+    if (!chunks)
+    {
+        snprintf(layer -> error.message, MAP_ERROR_LENGTH, "Failed to allocate %lluB in heap!\n", (unsigned long long) chunkBytes);
+        layer -> error.id = NOERRMESSAGE;
+        layer -> error.failed = 1;
+        free(chunkTable);
+        free(remap);
+        return;
+    }
+
+    WORLDTile * wideChunks = encoding == LAYER_ENCODING_WIDE ? (WORLDTile *) chunks : NULL;
+    WORLDTile * chunkPalette = encoding == LAYER_ENCODING_PALETTE ? (WORLDTile *) chunks : NULL;
+    uint8_t * indices = encoding == LAYER_ENCODING_PALETTE ? chunks + LAYER_PALETTE_SIZE * sizeof(WORLDTile) : NULL;
+    if (chunkPalette) memcpy(chunkPalette, palette, sizeof(palette));
+
+    // Filling chunks
+
+    for (uint32_t i = 0; i < layer -> amountOfTiles; i++)
+    {
+        int32_t x = (reader -> project ? FloorDivide(tiles[i].x, reader -> tileSize) : tiles[i].x) - shiftX;
+        int32_t y = (reader -> project ? FloorDivide(tiles[i].y, reader -> tileSize) : tiles[i].y) - shiftY;
+        uint32_t chunk = chunkTable[((y >> WORLD_CHUNK_SHIFT) - chunkY) * chunksX + (x >> WORLD_CHUNK_SHIFT) - chunkX] - 1;
+        size_t tile = (size_t) chunk * WORLD_CHUNK_TILES + (y & (WORLD_CHUNK_SIZE - 1)) * WORLD_CHUNK_SIZE + (x & (WORLD_CHUNK_SIZE - 1));
+
+        if (indices) indices[tile] = remap[(WORLDTile) (tiles[i].textureID + 1)];
+        else wideChunks[tile] = tiles[i].textureID + 1;
+    }
+
+    free(remap);
+
+    dest -> chunkTable = chunkTable;
+    dest -> encoding = encoding;
+    dest -> tiles = wideChunks;
+    dest -> palette = chunkPalette;
+    dest -> indices = indices;
+    dest -> amountOfChunks = amountOfChunks;
+    dest -> chunkX = chunkX;
+    dest -> chunkY = chunkY;
+    dest -> chunksX = chunksX;
+    dest -> chunksY = chunksY;
+    dest -> offsetX = OffsetX;
+    dest -> offsetY = OffsetY;
+    dest -> sizeX = SizeX;
+    dest -> sizeY = SizeY;
+
+    if (!InitLayerSpans(dest))
+    {
+        snprintf(layer -> error.message, MAP_ERROR_LENGTH, "Failed to allocate the row spans of a %ux%u layer!\n", dest -> sizeX, dest -> sizeY);
+        layer -> error.id = NOERRMESSAGE;
+        layer -> error.failed = 1;
+    }
+}
+
+// One per-layer step of CreateTilemapFromJSON, layers are handed out to threads through (next)
+typedef struct map_jobs
+{
+    void (*run)(struct map_jobs * jobs, uint16_t layer);
+    const uint16_t * order; // Layers biggest first, so a big layer isn't left for last
+    uint16_t amount;
+    atomic_uint next;
+
+    map_reader * reader;
+    WORLDSpriteSheetDecoder decoder; // Sprite sheets are decoded with the layers if it isn't NULL (jobs after the layers)
+    WORLDTilemap * tilemap;
+    int32_t shiftX;
+    int32_t shiftY;
+} map_jobs;
+
+// Runs layers of (jobs) until there aren't any left
+static void RunMapJobs(map_jobs * jobs)
+{
+    unsigned int i;
+    while ((i = atomic_fetch_add(&jobs -> next, 1)) < jobs -> amount) jobs -> run(jobs, jobs -> order[i]);
+}
+
+#ifdef _WIN32
+
+    static DWORD WINAPI MapJobThread(LPVOID jobs)
+    {
+        RunMapJobs(jobs);
+        return 0;
+    }
+
+#else
+
+    static void * MapJobThread(void * jobs)
+    {
+        RunMapJobs(jobs);
+        return NULL;
+    }
+
+#endif
+
+// Runs every layer of (jobs) on up to MAX_MAP_LOAD_THREADS threads (the calling thread is one of them) and waits for them
+static void RunMapJobsOnThreads(map_jobs * jobs)
+{
+    atomic_init(&jobs -> next, 0);
+
+    #ifdef _WIN32
+
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    long amountOfThreads = system.dwNumberOfProcessors;
+
+    #else
+
+    long amountOfThreads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    #endif
+
+    if (amountOfThreads > MAX_MAP_LOAD_THREADS) amountOfThreads = MAX_MAP_LOAD_THREADS;
+    if (amountOfThreads > jobs -> amount) amountOfThreads = jobs -> amount;
+
+    // If a thread can't be started its layers just go to the other ones
+
+    #ifdef _WIN32
+
+    HANDLE threads[MAX_MAP_LOAD_THREADS];
+    long started = 0;
+    while (started < amountOfThreads - 1 && (threads[started] = CreateThread(NULL, 0, MapJobThread, jobs, 0, NULL))) started++;
+
+    RunMapJobs(jobs);
+
+    for (long i = 0; i < started; i++)
+    {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+
+    #else
+
+    pthread_t threads[MAX_MAP_LOAD_THREADS];
+    long started = 0;
+    while (started < amountOfThreads - 1 && !pthread_create(threads + started, NULL, MapJobThread, jobs)) started++;
+
+    RunMapJobs(jobs);
+
+    for (long i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    #endif
+}
+
+// Parses one layer found by ParseMap, or decodes one sprite sheet (the jobs after the layers)
+static void ParseMapJob(map_jobs * jobs, uint16_t index)
+{
+    if (index >= jobs -> reader -> amountOfLayers)
+    {
+        DecodeMapSpriteSheet(jobs -> reader -> sheets + index - jobs -> reader -> amountOfLayers, jobs -> decoder);
+        return;
+    }
+
+    intermediate_layer * layer = jobs -> reader -> layers + index;
+    map_reader reader = {.text = jobs -> reader -> text, .position = layer -> json, .end = layer -> jsonEnd,
+                         .sheets = jobs -> reader -> sheets, .amountOfSheets = jobs -> reader -> amountOfSheets};
+    ParseMapLayer(&reader, layer);
+    layer -> error = reader.error;
+}
+
+// Gets how much JSON a job of ParseMapJob has to go through (the layer object or the sheet's base64)
+static size_t GetMapJobSize(const map_reader * reader, uint16_t index)
+{
+    if (index >= reader -> amountOfLayers) return reader -> sheets[index - reader -> amountOfLayers].dataLength;
+    return reader -> layers[index].jsonEnd - reader -> layers[index].json;
+}
+
+// Converts one parsed layer to chunks
+static void InitTitlemapLayerJob(map_jobs * jobs, uint16_t index)
+{
+    InitTitlemapLayer(jobs -> tilemap -> layers + index, jobs -> reader -> layers + index, jobs -> reader, jobs -> shiftX, jobs -> shiftY);
+}
+
+// Loads a Spritefusion map JSON for CreateTilemapFromJSON and CreateTilemapFromProject, sprite sheets are decoded with
+// (decoder) and put in (sheets) if it isn't NULL
+static WORLDTilemap * LoadTilemapJSON(const char * jsonPath, WORLDSpriteSheetDecoder decoder, WORLDSpriteSheetFree freeImage,
+                                      WORLDSpriteSheets * sheets)
+{
+    if (sheets) *sheets = (WORLDSpriteSheets) {0};
+
+    // Resets Error Detection
+
+    EncounterError = 0;
+
+    size_t length;
+    char * text = ReadMapFile(jsonPath, &length);
+
+    if (!text)
+    {
+        printf("Invalid Path \"%s\"!\n", jsonPath);
+        ErrorEncountered(NOERRMESSAGE);
+        return NULL;
+    }
+
+    // Finds the layers in one pass over the root object, then parses them in parallel
+
+    map_reader reader = {.text = text, .position = text, .end = text + length, .mapWidth = -1, .mapHeight = -1,
+                         .freeImage = decoder ? freeImage : NULL};
+    ParseMap(&reader);
+    ReportMapError(&reader.error);
+
+    // The sprite sheets are decoded alongside the layers (the jobs after them), so it all fits in one uint16_t
+
+    uint16_t amountOfSheets = decoder ? reader.amountOfSheets : 0;
+    if (!EncounterError && (uint32_t) reader.amountOfLayers + amountOfSheets > UINT16_MAX) ErrorEncountered(BADOBJECT);
+
+    uint16_t amountOfJobs = reader.amountOfLayers + amountOfSheets;
+    uint16_t * order = NULL;
+    if (!EncounterError)
+    {
+        order = malloc(sizeof(uint16_t) * (amountOfJobs ? amountOfJobs : 1));
+        if (!order) ErrorEncountered(FMALLOC);
+    }
+
+    if (!EncounterError)
+    {
+        // Biggest first (by how much JSON they are)
+
+        for (uint16_t i = 0; i < amountOfJobs; i++)
+        {
+            uint16_t j = i;
+            for (; j > 0 && GetMapJobSize(&reader, order[j - 1]) < GetMapJobSize(&reader, i); j--) order[j] = order[j - 1];
+            order[j] = i;
+        }
+
+        map_jobs parse = {.run = ParseMapJob, .order = order, .amount = amountOfJobs, .reader = &reader, .decoder = decoder};
+        RunMapJobsOnThreads(&parse);
+
+        for (uint16_t i = 0; i < reader.amountOfLayers && !EncounterError; i++)
+        {
+            ReportMapError(&reader.layers[i].error);
+            if (!EncounterError) PrintMapLayerWarnings(reader.layers + i);
+            reader.project |= reader.layers[i].project;
+        }
+        for (uint16_t i = 0; i < amountOfSheets && !EncounterError; i++) ReportMapError(&reader.sheets[i].error);
+
+        // Layers only from here on
+
+        uint16_t layer = 0;
+        for (uint16_t i = 0; i < amountOfJobs; i++) if (order[i] < reader.amountOfLayers) order[layer++] = order[i];
+    }
+
+    if (!EncounterError && reader.project && reader.tileSize <= 0)
+    {
+        printf("Invalid Spritefusion project (tileSize is %d)!\n", reader.tileSize);
+        ErrorEncountered(NOERRMESSAGE);
+    }
+
+    // Tile ids of project files are per sprite sheet
+
+    if (!EncounterError && reader.amountOfSheets) RemapSpriteSheetTiles(&reader, sheets);
+
+    if (!EncounterError && sheets && amountOfSheets)
+    {
+        sheets -> images = malloc(sizeof(void *) * amountOfSheets);
+        if (!sheets -> images) ErrorEncountered(FMALLOC);
+        else
+        {
+            for (uint16_t i = 0; i < amountOfSheets; i++)
+            {
+                sheets -> images[i] = reader.sheets[i].image;
+                reader.sheets[i].image = NULL;
+            }
+            sheets -> amount = amountOfSheets;
+            sheets -> tileSize = reader.tileSize;
+        }
+    }
+
+    free(text);
+
+    if (EncounterError)
+    {
+        FreeMapReader(&reader);
+        if (sheets) FreeSpriteSheets(sheets, freeImage);
+        free(order);
+        return NULL;
+    }
+
+    // Project files use pixel positions around the origin, so they're shifted to start at tile 0, 0
+
+    int32_t shiftX = 0, shiftY = 0;
+    int32_t maxX = 0, maxY = 0;
+
+    if (reader.project)
+    {
+        shiftX = INT32_MAX, shiftY = INT32_MAX;
+        maxX = INT32_MIN, maxY = INT32_MIN;
+
+        for (uint16_t i = 0; i < reader.amountOfLayers; i++)
+        {
+            if (!reader.layers[i].amountOfTiles) continue;
+            if (shiftX > FloorDivide(reader.layers[i].minX, reader.tileSize)) shiftX = FloorDivide(reader.layers[i].minX, reader.tileSize);
+            if (shiftY > FloorDivide(reader.layers[i].minY, reader.tileSize)) shiftY = FloorDivide(reader.layers[i].minY, reader.tileSize);
+            if (maxX < FloorDivide(reader.layers[i].maxX, reader.tileSize)) maxX = FloorDivide(reader.layers[i].maxX, reader.tileSize);
+            if (maxY < FloorDivide(reader.layers[i].maxY, reader.tileSize)) maxY = FloorDivide(reader.layers[i].maxY, reader.tileSize);
+        }
+        if (shiftX > maxX) shiftX = maxX = shiftY = maxY = 0;
+    }
+
+    // Gets map size to be potentially used for camera collisions (with the void)
+
+    int64_t mapWidth = reader.mapWidth >= 0 ? reader.mapWidth : reader.project ? (int64_t) maxX - shiftX + 1 : UINT16_MAX;
+    int64_t mapHeight = reader.mapHeight >= 0 ? reader.mapHeight : reader.project ? (int64_t) maxY - shiftY + 1 : UINT16_MAX;
+
+    // Allocates tilemap struct and layer memory
+
+    WORLDTilemap * tilemap = malloc(sizeof(WORLDTilemap));
+    if (tilemap) tilemap -> layers = calloc(reader.amountOfLayers ? reader.amountOfLayers : 1, sizeof(WORLDTilemapLayer));
+
+    if (!tilemap || !tilemap -> layers)
+    {
+        ErrorEncountered(FMALLOC);
+        free(tilemap);
+        FreeMapReader(&reader);
+        if (sheets) FreeSpriteSheets(sheets, freeImage);
+        free(order);
+        return NULL;
+    }
+
+    tilemap -> amount = reader.amountOfLayers;
+    tilemap -> mapping = NULL;
+    tilemap -> mappingSize = 0;
+    tilemap -> collision = NULL;
+    tilemap -> mapWidth = mapWidth < UINT16_MAX ? mapWidth : UINT16_MAX;
+    tilemap -> mapHeight = mapHeight < UINT16_MAX ? mapHeight : UINT16_MAX;
+
+    // Converts all layers to chunks, in parallel too
+
+    map_jobs build = {.run = InitTitlemapLayerJob, .order = order, .amount = reader.amountOfLayers, .reader = &reader,
+                      .tilemap = tilemap, .shiftX = shiftX, .shiftY = shiftY};
+    RunMapJobsOnThreads(&build);
+
+    for (uint16_t i = 0; i < reader.amountOfLayers && !EncounterError; i++) ReportMapError(&reader.layers[i].error);
+
+    FreeMapReader(&reader);
+    free(order);
+
+    if (!EncounterError && !BuildCollisionGrid(tilemap, NULL)) ErrorEncountered(FMALLOC);
+
+    if (EncounterError)
+    {
+        FreeTilemap(tilemap);
+        if (sheets) FreeSpriteSheets(sheets, freeImage);
+        return NULL;
+    }
+    return tilemap;
+}
+
+// Returns the address of a parsed tilemap based on a Spritefusion map JSON (map export or project file)
+// Layers are parsed and converted on worker threads, errors are printed afterwards in layer order
+WORLDTilemap * CreateTilemapFromJSON(const char * jsonPath)
+{
+    return LoadTilemapJSON(jsonPath, NULL, NULL, NULL);
+}
+
+// Same as CreateTilemapFromJSON, but the sprite sheets embedded in a Spritefusion project file are decoded with (decoder)
+// on the same threads as the layers and put in (sheets) with which sheet tile every WORLDTile is (free it with FreeSpriteSheets)
+// On failure the decoded images are freed with (freeImage)
+WORLDTilemap * CreateTilemapFromProject(const char * jsonPath, WORLDSpriteSheetDecoder decoder, WORLDSpriteSheetFree freeImage,
+                                        WORLDSpriteSheets * sheets)
+{
+    return LoadTilemapJSON(jsonPath, decoder, freeImage, sheets);
+}
+
+// Frees what CreateTilemapFromProject put in (sheets), the images too with (freeImage) if it isn't NULL
+void FreeSpriteSheets(WORLDSpriteSheets * sheets, WORLDSpriteSheetFree freeImage)
+{
+    for (uint16_t i = 0; i < sheets -> amount; i++) if (freeImage && sheets -> images[i]) freeImage(sheets -> images[i]);
+    free(sheets -> images);
+    free(sheets -> tiles);
+    *sheets = (WORLDSpriteSheets) {0};
+}
+
+_Static_assert(sizeof(YWMAPHeader) == 16 && sizeof(YWMAPLayer) == 48, "The .ywmap headers must not have padding");
+
+// Rounds a .ywmap file offset up to YWMAP_ALIGNMENT
+static uint64_t AlignYWMAPOffset(uint64_t offset)
+{
+    return (offset + YWMAP_ALIGNMENT - 1) & ~(uint64_t) (YWMAP_ALIGNMENT - 1);
+}
+
+// Maps a whole file into memory copy-on-write (the game can still write to the layer tiles), returns NULL on failure
+static void * MapTilemapFile(const char * path, size_t * size)
+{
+    #ifdef _WIN32
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = NULL;
+    void * view = NULL;
+
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && (uint64_t) fileSize.QuadPart <= SIZE_MAX)
+        mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping) view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+    // The view keeps the file mapped after the handles are closed
+
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+
+    *size = view ? (size_t) fileSize.QuadPart : 0;
+    return view;
+
+    #else
+
+    int file = open(path, O_RDONLY);
+    if (file < 0) return NULL;
+
+    struct stat info;
+    void * view = NULL;
+
+    if (!fstat(file, &info) && info.st_size > 0)
+    {
+        view = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (view == MAP_FAILED) view = NULL;
+    }
+    close(file);
+
+    *size = view ? (size_t) info.st_size : 0;
+    return view;
+
+    #endif
+}
+
+// Unmaps a file mapped by MapTilemapFile
+static void UnmapTilemapFile(void * view, size_t size)
+{
+    #ifdef _WIN32
+
+    (void) size;
+    UnmapViewOfFile(view);
+
+    #else
+
+    munmap(view, size);
+
+    #endif
+}
+
+// Maps a compiled .ywmap file into memory and points the layer tiles into it, NULL on failure
+WORLDTilemap * LoadTilemapBinary(const char * path)
+{
+    size_t size;
+    uint8_t * file = MapTilemapFile(path, &size);
+
+    if (!file)
+    {
+        printf("Couldn't map \"%s\"!\n", path);
+        return NULL;
+    }
+
+    // Checks the headers before anything points into the file
+
+    const YWMAPHeader * header = (const YWMAPHeader *) file;
+    const YWMAPLayer * layers = (const YWMAPLayer *) (header + 1);
+    const char * problem = NULL;
+
+    if (size < sizeof(YWMAPHeader) || header -> magic != YWMAP_MAGIC) problem = "not a .ywmap or wrong byte order";
+    else if (header -> version != YWMAP_VERSION) problem = "wrong version";
+    else if (size < sizeof(YWMAPHeader) + (uint64_t) sizeof(YWMAPLayer) * header -> amount) problem = "truncated layer headers";
+
+    for (uint16_t i = 0; !problem && i < header -> amount; i++)
+    {
+        uint64_t tableSize = (uint64_t) layers[i].chunksX * layers[i].chunksY * sizeof(uint32_t);
+        uint64_t tilesSize = LAYER_CHUNK_BYTES((uint64_t) layers[i].amountOfChunks, layers[i].encoding);
+        if (!tableSize) continue;
+
+        if (layers[i].encoding > LAYER_ENCODING_PALETTE)
+        {
+            problem = "unknown layer encoding";
+            break;
+        }
+
+        if (layers[i].chunkTable % YWMAP_ALIGNMENT || layers[i].chunkTable + tableSize > size ||
+            layers[i].tiles % YWMAP_ALIGNMENT || layers[i].tiles + tilesSize > size)
+        {
+            problem = "layer chunks out of the file";
+            break;
+        }
+
+        // A broken chunk table would make AccessPositionInLayer read outside the file
+
+        const uint32_t * chunkTable = (const uint32_t *) (file + layers[i].chunkTable);
+        for (uint32_t chunk = 0; chunk < tableSize / sizeof(uint32_t); chunk++)
+            if (chunkTable[chunk] > layers[i].amountOfChunks) problem = "bad chunk table";
+
+        // Same for row spans (RenderLayer skips spans that end up on empty chunks, so they only need to be in the layer)
+
+        uint64_t rowSpansSize = ((uint64_t) layers[i].sizeY + 1) * sizeof(uint32_t);
+        uint64_t spansSize = (uint64_t) layers[i].amountOfSpans * sizeof(WORLDTileSpan);
+
+        if (problem || layers[i].rowSpans % YWMAP_ALIGNMENT || layers[i].rowSpans + rowSpansSize > size ||
+            layers[i].spans % YWMAP_ALIGNMENT || layers[i].spans + spansSize > size)
+        {
+            if (!problem) problem = "layer row spans out of the file";
+            break;
+        }
+
+        const uint32_t * rowSpans = (const uint32_t *) (file + layers[i].rowSpans);
+        const WORLDTileSpan * spans = (const WORLDTileSpan *) (file + layers[i].spans);
+        if (rowSpans[0] || rowSpans[layers[i].sizeY] != layers[i].amountOfSpans) problem = "bad row spans";
+
+        for (uint32_t y = 0; !problem && y < layers[i].sizeY; y++)
+        {
+            if (rowSpans[y] > rowSpans[y + 1]) problem = "bad row spans";
+            for (uint32_t span = rowSpans[y]; !problem && span < rowSpans[y + 1]; span++)
+            {
+                if (spans[span].start < layers[i].offsetX || !spans[span].length ||
+                    (uint32_t) spans[span].start + spans[span].length > (uint32_t) layers[i].offsetX + layers[i].sizeX)
+                    problem = "bad row spans";
+            }
+        }
+    }
+
+    WORLDTilemap * tilemap = problem ? NULL : malloc(sizeof(WORLDTilemap));
+    if (tilemap) tilemap -> layers = calloc(header -> amount ? header -> amount : 1, sizeof(WORLDTilemapLayer));
+
+    if (!tilemap || !tilemap -> layers)
+    {
+        if (problem) printf("Invalid .ywmap \"%s\" (%s)!\n", path, problem);
+        else ErrorEncountered(FMALLOC);
+        free(tilemap);
+        UnmapTilemapFile(file, size);
+        return NULL;
+    }
+
+    tilemap -> amount = header -> amount;
+    tilemap -> mapWidth = header -> mapWidth;
+    tilemap -> mapHeight = header -> mapHeight;
+    tilemap -> mapping = file;
+    tilemap -> mappingSize = size;
+    tilemap -> collision = NULL;
+
+    // The chunks are already laid out the way WORLDTilemapLayer expects, so the layers just point at them
+
+    for (uint16_t i = 0; i < header -> amount; i++)
+    {
+        _Bool empty = !layers[i].chunksX || !layers[i].chunksY;
+
+        tilemap -> layers[i].offsetX = layers[i].offsetX;
+        tilemap -> layers[i].offsetY = layers[i].offsetY;
+        tilemap -> layers[i].sizeX = layers[i].sizeX;
+        tilemap -> layers[i].sizeY = layers[i].sizeY;
+        tilemap -> layers[i].chunkX = layers[i].chunkX;
+        tilemap -> layers[i].chunkY = layers[i].chunkY;
+        tilemap -> layers[i].chunksX = empty ? 0 : layers[i].chunksX;
+        tilemap -> layers[i].chunksY = empty ? 0 : layers[i].chunksY;
+        tilemap -> layers[i].chunkTable = empty ? NULL : (uint32_t *) (file + layers[i].chunkTable);
+        tilemap -> layers[i].encoding = empty ? LAYER_ENCODING_WIDE : layers[i].encoding;
+        tilemap -> layers[i].tiles = empty || layers[i].encoding != LAYER_ENCODING_WIDE ? NULL : (WORLDTile *) (file + layers[i].tiles);
+        tilemap -> layers[i].palette = empty || layers[i].encoding != LAYER_ENCODING_PALETTE ? NULL : (WORLDTile *) (file + layers[i].tiles);
+        tilemap -> layers[i].indices = tilemap -> layers[i].palette ? (uint8_t *) (tilemap -> layers[i].palette + LAYER_PALETTE_SIZE) : NULL;
+        tilemap -> layers[i].amountOfChunks = empty ? 0 : layers[i].amountOfChunks;
+        tilemap -> layers[i].rowSpans = empty ? NULL : (uint32_t *) (file + layers[i].rowSpans);
+        tilemap -> layers[i].spans = empty ? NULL : (WORLDTileSpan *) (file + layers[i].spans);
+        tilemap -> layers[i].FLAGS = layers[i].FLAGS;
+    }
+
+    if (!BuildCollisionGrid(tilemap, NULL))
+    {
+        ErrorEncountered(FMALLOC);
+        FreeTilemap(tilemap);
+        return NULL;
+    }
+    return tilemap;
+}
+
+// Writes a tilemap as a compiled .ywmap file, returns 1 on success
+_Bool SaveTilemapBinary(const WORLDTilemap * tilemap, const char * path)
+{
+    FILE * file = fopen(path, "wb");
+    if (!file)
+    {
+        printf("Couldn't create \"%s\"!\n", path);
+        return 0;
+    }
+
+    YWMAPHeader header = {YWMAP_MAGIC, YWMAP_VERSION, tilemap -> amount, tilemap -> mapWidth, tilemap -> mapHeight, 0};
+    _Bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // Layer headers, the chunk tables and chunks come after all of them
+
+    uint64_t offset = AlignYWMAPOffset(sizeof(YWMAPHeader) + sizeof(YWMAPLayer) * tilemap -> amount);
+
+    for (uint16_t i = 0; success && i < tilemap -> amount; i++)
+    {
+        const WORLDTilemapLayer * layer = tilemap -> layers + i;
+        uint64_t tableSize = (uint64_t) layer -> chunksX * layer -> chunksY * sizeof(uint32_t);
+        uint64_t tilesSize = LAYER_CHUNK_BYTES((uint64_t) layer -> amountOfChunks, layer -> encoding);
+        uint64_t tiles = AlignYWMAPOffset(offset + tableSize);
+        uint64_t rowSpansSize = tableSize ? ((uint64_t) layer -> sizeY + 1) * sizeof(uint32_t) : 0;
+        uint32_t amountOfSpans = tableSize ? layer -> rowSpans[layer -> sizeY] : 0;
+        uint64_t rowSpans = AlignYWMAPOffset(tiles + tilesSize);
+        uint64_t spans = AlignYWMAPOffset(rowSpans + rowSpansSize);
+
+        YWMAPLayer entry = {layer -> offsetX, layer -> offsetY, layer -> sizeX, layer -> sizeY,
+                            layer -> chunkX, layer -> chunkY, layer -> chunksX, layer -> chunksY, layer -> amountOfChunks,
+                            tableSize ? offset : 0, tableSize ? tiles : 0, layer -> FLAGS, layer -> encoding, {0},
+                            tableSize ? rowSpans : 0, tableSize ? spans : 0, amountOfSpans, 0};
+        if (spans + amountOfSpans * sizeof(WORLDTileSpan) > UINT32_MAX) success = 0;
+        else success = fwrite(&entry, sizeof(entry), 1, file) == 1;
+
+        if (tableSize) offset = AlignYWMAPOffset(spans + amountOfSpans * sizeof(WORLDTileSpan));
+    }
+
+    // Chunk tables, chunks and row spans
+
+    static const uint8_t padding[YWMAP_ALIGNMENT] = {0};
+
+    for (uint16_t i = 0; success && i < tilemap -> amount; i++)
+    {
+        const WORLDTilemapLayer * layer = tilemap -> layers + i;
+        size_t tableSize = (size_t) layer -> chunksX * layer -> chunksY * sizeof(uint32_t);
+        size_t tilesSize = LAYER_CHUNK_BYTES(layer -> amountOfChunks, layer -> encoding);
+        const void * tiles = layer -> encoding == LAYER_ENCODING_PALETTE ? (const void *) layer -> palette : (const void *) layer -> tiles;
+        if (!tableSize) continue;
+
+        long position = ftell(file);
+        size_t paddingSize = AlignYWMAPOffset(position) - position;
+        success = fwrite(padding, 1, paddingSize, file) == paddingSize && fwrite(layer -> chunkTable, 1, tableSize, file) == tableSize;
+
+        position = ftell(file);
+        paddingSize = AlignYWMAPOffset(position) - position;
+        success = success && fwrite(padding, 1, paddingSize, file) == paddingSize && fwrite(tiles, 1, tilesSize, file) == tilesSize;
+
+        size_t rowSpansSize = ((size_t) layer -> sizeY + 1) * sizeof(uint32_t);
+        size_t spansSize = (size_t) layer -> rowSpans[layer -> sizeY] * sizeof(WORLDTileSpan);
+
+        position = ftell(file);
+        paddingSize = AlignYWMAPOffset(position) - position;
+        success = success && fwrite(padding, 1, paddingSize, file) == paddingSize && fwrite(layer -> rowSpans, 1, rowSpansSize, file) == rowSpansSize;
+
+        position = ftell(file);
+        paddingSize = AlignYWMAPOffset(position) - position;
+        success = success && fwrite(padding, 1, paddingSize, file) == paddingSize && fwrite(layer -> spans, 1, spansSize, file) == spansSize;
+    }
+
+    if (fclose(file) || !success)
+    {
+        printf("Failed to write \"%s\"!\n", path);
+        remove(path);
+        return 0;
+    }
+    return 1;
+}
+
+// Returns the address of a tilemap based on a Spritefusion map JSON (map export or project file), NULL on failure
+// Loads the compiled .ywmap next to it instead if there is one that isn't older than the JSON (or if jsonPath is a .ywmap)
+WORLDTilemap * CreateTilemap(const char * jsonPath)
+{
+    const char * extension = strrchr(jsonPath, '.');
+    if (extension && !strcmp(extension, YWMAP_EXTENSION)) return LoadTilemapBinary(jsonPath);
+
+    // "maps/map.json" -> "maps/map.ywmap"
+
+    char binaryPath[1024];
+    size_t baseLength = extension && !strpbrk(extension, "/\\") ? (size_t) (extension - jsonPath) : strlen(jsonPath);
+
+    struct stat binaryInfo, jsonInfo;
+
+    if (baseLength + sizeof(YWMAP_EXTENSION) <= sizeof(binaryPath))
+    {
+        memcpy(binaryPath, jsonPath, baseLength);
+        memcpy(binaryPath + baseLength, YWMAP_EXTENSION, sizeof(YWMAP_EXTENSION));
+
+        if (!stat(binaryPath, &binaryInfo))
+        {
+            if (!stat(jsonPath, &jsonInfo) && jsonInfo.st_mtime > binaryInfo.st_mtime)
+                printf("\"%s\" is older than \"%s\", loading the JSON (run make maps)\n", binaryPath, jsonPath);
+            else
+            {
+                WORLDTilemap * tilemap = LoadTilemapBinary(binaryPath);
+                if (tilemap) return tilemap;
+            }
+        }
+    }
+
+    return CreateTilemapFromJSON(jsonPath);
+}
+
+// Frees a tilemap returned by CreateTilemap (and all of its layers)
+void FreeTilemap(WORLDTilemap * tilemap)
+{
+    if (!tilemap) return;
+    free(tilemap -> collision);
+
+    // Visible row spans are always allocated, even for mapped tilemaps
+
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        free(tilemap -> layers[i].visibleRowSpans);
+        free(tilemap -> layers[i].visibleSpans);
+    }
+
+    if (tilemap -> mapping) UnmapTilemapFile(tilemap -> mapping, tilemap -> mappingSize);
+    else for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        free(tilemap -> layers[i].rowSpans);
+        free(tilemap -> layers[i].spans);
+        free(tilemap -> layers[i].chunkTable);
+        free(tilemap -> layers[i].tiles);
+        free(tilemap -> layers[i].palette);
+    }
+    free(tilemap -> layers);
+    free(tilemap);
+}
+
+// Returns the metadata table of a spritesheet with tileSize x tileSize tiles (row by row), NULL on failure
+WORLDTileset * CreateTileset(uint16_t sheetWidth, uint16_t sheetHeight, uint16_t tileSize)
+{
+    if (!tileSize || sheetWidth < tileSize || sheetHeight < tileSize)
+    {
+        printf("Invalid spritesheet (%ux%u with %upx tiles)!\n", sheetWidth, sheetHeight, tileSize);
+        return NULL;
+    }
+
+    uint16_t columns = sheetWidth / tileSize;
+    uint32_t amount = (uint32_t) columns * (sheetHeight / tileSize) + 1;
+    if (amount > UINT16_MAX) amount = UINT16_MAX;
+
+    WORLDTileset * tileset = malloc(sizeof(WORLDTileset));
+    if (tileset) tileset -> tiles = calloc(amount, sizeof(WORLDTileInfo));
+
+    if (!tileset || !tileset -> tiles)
+    {
+        ErrorEncountered(FMALLOC);
+        free(tileset);
+        return NULL;
+    }
+
+    tileset -> amount = amount;
+    tileset -> tileSize = tileSize;
+    tileset -> amountOfPages = 1;
+
+    // tiles[0] is the empty tile and stays zeroed
+
+    for (uint32_t i = 1; i < amount; i++)
+    {
+        tileset -> tiles[i].sourceX = (i - 1) % columns * tileSize;
+        tileset -> tiles[i].sourceY = (i - 1) / columns * tileSize;
+    }
+    return tileset;
+}
+
+// Adds another spritesheet to a tileset as its next page, its tiles get the WORLDTiles after the ones already there
+// Returns the WORLDTile of its first tile, 0 on failure
+WORLDTile AddTilesetPage(WORLDTileset * tileset, uint16_t sheetWidth, uint16_t sheetHeight)
+{
+    uint16_t tileSize = tileset -> tileSize;
+    uint16_t columns = sheetWidth / tileSize;
+    uint32_t amount = tileset -> amount + (uint32_t) columns * (sheetHeight / tileSize);
+
+    if (!columns || sheetHeight < tileSize || tileset -> amountOfPages == MAX_TILESET_PAGES || amount > UINT16_MAX)
+    {
+        printf("Invalid spritesheet page %u (%ux%u with %upx tiles)!\n", tileset -> amountOfPages, sheetWidth, sheetHeight, tileSize);
+        return 0;
+    }
+
+    WORLDTileInfo * tiles = realloc(tileset -> tiles, sizeof(WORLDTileInfo) * amount);
+    if (!tiles)
+    {
+        ErrorEncountered(FMALLOC);
+        return 0;
+    }
+    tileset -> tiles = tiles;
+
+    WORLDTile first = tileset -> amount;
+    for (uint32_t i = first; i < amount; i++)
+    {
+        tiles[i].sourceX = (i - first) % columns * tileSize;
+        tiles[i].sourceY = (i - first) / columns * tileSize;
+        tiles[i].FLAGS = 0;
+        tiles[i].page = tileset -> amountOfPages;
+    }
+
+    tileset -> amount = amount;
+    tileset -> amountOfPages++;
+    return first;
+}
+
+// Sets tile FLAGS from a tile metadata JSON ({"solid": [ids], "water": [...], "grass": [...], "animated": [...], "opaque": [...]})
+// Returns 1 on success
+_Bool LoadTilesetFlags(WORLDTileset * tileset, const char * path)
+{
+    size_t length;
+    char * text = ReadMapFile(path, &length);
+
+    if (!text)
+    {
+        printf("Invalid Path \"%s\"!\n", path);
+        return 0;
+    }
+
+    map_reader reader = {.text = text, .position = text, .end = text + length};
+
+    if (!IsMapContainerEmpty(&reader, '{', '}'))
+    {
+        do
+        {
+            const char * key;
+            size_t keyLength;
+            ReadMapKey(&reader, &key, &keyLength);
+            if (reader.error.failed) break;
+
+            uint8_t flag = MAP_KEY_IS(key, keyLength, "solid") ? TILE_SOLID : MAP_KEY_IS(key, keyLength, "water") ? TILE_WATER :
+                           MAP_KEY_IS(key, keyLength, "grass") ? TILE_GRASS : MAP_KEY_IS(key, keyLength, "animated") ? TILE_ANIMATED :
+                           MAP_KEY_IS(key, keyLength, "opaque") ? TILE_OPAQUE : 0;
+
+            if (!flag)
+            {
+                SkipMapValue(&reader);
+                continue;
+            }
+
+            // Spritefusion ids, the ones past the end of the spritesheet are ignored
+
+            if (IsMapContainerEmpty(&reader, '[', ']')) continue;
+            do
+            {
+                int32_t id = ReadMapInteger(&reader);
+                if (id >= 0 && id < tileset -> amount - 1) tileset -> tiles[id + 1].FLAGS |= flag;
+            } while (!reader.error.failed && NextMapMember(&reader, ']'));
+        } while (!reader.error.failed && NextMapMember(&reader, '}'));
+    }
+
+    free(text);
+    ReportMapError(&reader.error);
+    return !reader.error.failed;
+}
+
+// Frees a tileset returned by CreateTileset
+void FreeTileset(WORLDTileset * tileset)
+{
+    if (!tileset) return;
+    free(tileset -> tiles);
+    free(tileset);
+}
+
+// Returns the FLAGS of every tile at a position OR-ed together (all layers)
+uint8_t GetTileFlagsAt(const WORLDTilemap * tilemap, const WORLDTileset * tileset, uint16_t x, uint16_t y)
+{
+    uint8_t flags = 0;
+    for (uint16_t i = 0; i < tilemap -> amount; i++)
+    {
+        WORLDTile tile = AccessPositionInLayer(x, y, tilemap -> layers + i);
+        if (tile < tileset -> amount) flags |= tileset -> tiles[tile].FLAGS;
+    }
+    return flags;
+}
+
+// Reads a number with its fraction (object positions aren't whole tiles)
+static float ReadMapFloat(map_reader * reader)
+{
+    PeekMapToken(reader);
+
+    char * after;
+    float value = strtof(reader -> position, &after);
+    if (after == reader -> position) MapReaderFailed(reader, BADJSON);
+    else reader -> position = after;
+    return value;
+}
+
+// Parses one object of an object layer JSON, (type) and (typeLength) point into the text
+static void ParseMapObject(map_reader * reader, WORLDObject * object, const char ** type, size_t * typeLength)
+{
+    _Bool hasX = 0, hasY = 0;
+    *object = (WORLDObject) {.width = 1, .height = 1};
+    *type = NULL;
+
+    if (IsMapContainerEmpty(reader, '{', '}'))
+    {
+        MapReaderFailed(reader, BADOBJECT);
+        return;
+    }
+
+    do
+    {
+        const char * key;
+        size_t length;
+        ReadMapKey(reader, &key, &length);
+        if (reader -> error.failed) return;
+
+        if (MAP_KEY_IS(key, length, "type")) ReadMapString(reader, type, typeLength);
+        else if (MAP_KEY_IS(key, length, "x")) object -> x = ReadMapFloat(reader), hasX = 1;
+        else if (MAP_KEY_IS(key, length, "y")) object -> y = ReadMapFloat(reader), hasY = 1;
+        else if (MAP_KEY_IS(key, length, "width")) object -> width = ReadMapFloat(reader);
+        else if (MAP_KEY_IS(key, length, "height")) object -> height = ReadMapFloat(reader);
+        else if (MAP_KEY_IS(key, length, "depth")) object -> depth = ReadMapInteger(reader);
+        else if (MAP_KEY_IS(key, length, "payload"))
+        {
+            if (IsMapContainerEmpty(reader, '[', ']')) continue;
+
+            uint8_t i = 0;
+            do
+            {
+                float value = ReadMapFloat(reader);
+                if (i < WORLD_OBJECT_PAYLOAD) object -> payload[i++] = value;
+            } while (!reader -> error.failed && NextMapMember(reader, ']'));
+        }
+        else SkipMapValue(reader);
+    } while (!reader -> error.failed && NextMapMember(reader, '}'));
+
+    if (reader -> error.failed) return;
+
+    if (!*type || !*typeLength || *typeLength >= WORLD_OBJECT_TYPE_LENGTH || !hasX || !hasY)
+    {
+        MapReaderFailed(reader, NOERRMESSAGE);
+        snprintf(reader -> error.message, MAP_ERROR_LENGTH, "Invalid map object \"%.*s\" (needs a type of up to %u characters, x and y)!\n",
+                 *type && *typeLength < 64 ? (int) *typeLength : 0, *type ? *type : "", WORLD_OBJECT_TYPE_LENGTH - 1);
+    }
+}
+
+// Loads an object layer JSON ({"objects": [{"type": "chest", "x": 1, "y": 2, "width": 1, "height": 1, "depth": 3,
+// "payload": [1, 0]}, ...]}, only type, x and y are required), NULL on failure
+WORLDObjectLayer * LoadObjectLayer(const char * path)
+{
+    size_t length;
+    char * text = ReadMapFile(path, &length);
+
+    if (!text)
+    {
+        printf("Invalid Path \"%s\"!\n", path);
+        return NULL;
+    }
+
+    map_reader reader = {.text = text, .position = text, .end = text + length};
+
+    // Objects are read in file order with the group they belong to, then moved next to the rest of their group
+
+    WORLDObject * parsed = NULL;
+    uint16_t * parsedGroups = NULL;
+    uint32_t amount = 0, capacity = 0;
+
+    WORLDObjectLayer * layer = calloc(1, sizeof(WORLDObjectLayer));
+    if (!layer) MapReaderFailed(&reader, FMALLOC);
+
+    if (!IsMapContainerEmpty(&reader, '{', '}'))
+    {
+        do
+        {
+            const char * key;
+            size_t keyLength;
+            ReadMapKey(&reader, &key, &keyLength);
+            if (reader.error.failed) break;
+
+            if (!MAP_KEY_IS(key, keyLength, "objects"))
+            {
+                SkipMapValue(&reader);
+                continue;
+            }
+
+            if (IsMapContainerEmpty(&reader, '[', ']')) continue;
+            do
+            {
+                if (amount == capacity)
+                {
+                    capacity = capacity ? capacity * 2 : 64;
+                    WORLDObject * objects = realloc(parsed, sizeof(WORLDObject) * capacity);
+                    if (objects) parsed = objects;
+                    uint16_t * groups = objects ? realloc(parsedGroups, sizeof(uint16_t) * capacity) : NULL;
+                    if (groups) parsedGroups = groups;
+                    if (!groups)
+                    {
+                        MapReaderFailed(&reader, FMALLOC);
+                        break;
+                    }
+                }
+
+                const char * type;
+                size_t typeLength;
+                ParseMapObject(&reader, parsed + amount, &type, &typeLength);
+                if (reader.error.failed) break;
+
+                // Finds the group of the type, a new one is made the first time a type is seen
+
+                uint16_t group = 0;
+                while (group < layer -> amountOfGroups &&
+                      (strlen(layer -> groups[group].type) != typeLength || memcmp(layer -> groups[group].type, type, typeLength)))
+                    group++;
+
+                if (group == layer -> amountOfGroups)
+                {
+                    WORLDObjectGroup * groups = group < UINT16_MAX ? realloc(layer -> groups, sizeof(WORLDObjectGroup) * (group + 1)) : NULL;
+                    if (!groups)
+                    {
+                        MapReaderFailed(&reader, FMALLOC);
+                        break;
+                    }
+                    layer -> groups = groups;
+                    layer -> groups[group] = (WORLDObjectGroup) {0};
+                    memcpy(layer -> groups[group].type, type, typeLength);
+                    layer -> amountOfGroups++;
+                }
+
+                layer -> groups[group].amount++;
+                parsedGroups[amount++] = group;
+            } while (!reader.error.failed && NextMapMember(&reader, ']'));
+        } while (!reader.error.failed && NextMapMember(&reader, '}'));
+    }
+
+    // Bulk allocation of every object, each group gets a contiguous part of it
+
+    if (!reader.error.failed && amount)
+    {
+        layer -> objects = malloc(sizeof(WORLDObject) * amount);
+        if (!layer -> objects) MapReaderFailed(&reader, FMALLOC);
+    }
+
+    if (!reader.error.failed)
+    {
+        uint32_t first = 0;
+        for (uint16_t i = 0; i < layer -> amountOfGroups; i++)
+        {
+            layer -> groups[i].objects = layer -> objects + first;
+            first += layer -> groups[i].amount;
+            layer -> groups[i].amount = 0;
+        }
+        for (uint32_t i = 0; i < amount; i++)
+        {
+            WORLDObjectGroup * group = layer -> groups + parsedGroups[i];
+            group -> objects[group -> amount++] = parsed[i];
+        }
+        layer -> amount = amount;
+    }
+
+    free(parsed);
+    free(parsedGroups);
+    free(text);
+
+    if (reader.error.failed)
+    {
+        printf("Invalid object layer \"%s\"! ", path);
+        ReportMapError(&reader.error);
+        FreeObjectLayer(layer);
+        return NULL;
+    }
+    return layer;
+}
+
+// Returns the objects of a type in an object layer (can be NULL), NULL if there aren't any
+const WORLDObjectGroup * GetObjectGroup(const WORLDObjectLayer * layer, const char * type)
+{
+    if (!layer) return NULL;
+    for (uint16_t i = 0; i < layer -> amountOfGroups; i++)
+    {
+        if (!strcmp(layer -> groups[i].type, type)) return layer -> groups + i;
+    }
+    return NULL;
+}
+
+// Frees an object layer returned by LoadObjectLayer
+void FreeObjectLayer(WORLDObjectLayer * layer)
+{
+    if (!layer) return;
+    free(layer -> objects);
+    free(layer -> groups);
+    free(layer);
+}
@@ -24,50 +24,339 @@
 
 #pragma once
 
-#include "../Include/cJSON.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
 
 typedef uint16_t WORLDTile;
 
+// Layers are stored as WORLD_CHUNK_SIZE x WORLD_CHUNK_SIZE chunks lined up with tile 0, 0, chunks without tiles aren't stored
+
+#define WORLD_CHUNK_SHIFT 5
+#define WORLD_CHUNK_SIZE (1 << WORLD_CHUNK_SHIFT)
+#define WORLD_CHUNK_TILES (WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE)
+
+// A run of tiles in one row of a layer with no empty tiles in it
+
+typedef struct WORLDTileSpan
+{
+    uint16_t start; // First tile position (X)
+    uint16_t length;
+} WORLDTileSpan;
+
 typedef struct WORLDTilemapLayer 
 {
-    // Transformation Variables
+    // Transformation Variables (bounds of the tiles in the layer)
 
     uint16_t offsetX;
     uint16_t offsetY;
     uint16_t sizeX;
     uint16_t sizeY;
 
-    void * tiles; // WORLDTile 2D Array Pointer
+    // Chunks
+
+    uint16_t chunkX; // First chunk column covered by the chunk table
+    uint16_t chunkY; // First chunk row covered by the chunk table
+    uint16_t chunksX;
+    uint16_t chunksY;
+
+    uint32_t * chunkTable; // [chunksY][chunksX], 0 for an empty chunk, otherwise 1 + the chunk's index in tiles / indices
+    uint32_t amountOfChunks;
+    uint8_t encoding; // LAYER_ENCODING_WIDE or LAYER_ENCODING_PALETTE, picked on load
+
+    WORLDTile * tiles; // Wide: WORLDTile[amountOfChunks][WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE], NULL for palette layers
+    WORLDTile * palette; // Palette: WORLDTile[LAYER_PALETTE_SIZE] (palette[0] is 0) with the indices right after it, NULL for wide layers
+    uint8_t * indices; // Palette: uint8_t[amountOfChunks][WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE] into palette
+
+    // Row spans (built on load, see GetLayerRowSpans)
+
+    uint32_t * rowSpans; // [sizeY + 1], the spans of row offsetY + y are spans[rowSpans[y]] up to spans[rowSpans[y + 1]]
+    WORLDTileSpan * spans; // Sorted by start in every row
+
+    // Visible row spans (baked by BakeTileOcclusion, see GetLayerVisibleRowSpans)
+    // The row spans without the tiles covered by TILE_OPAQUE tiles of lower layers, NULL if not baked
+
+    uint32_t * visibleRowSpans;
+    WORLDTileSpan * visibleSpans;
 
     // Flags
 
     uint8_t FLAGS;
 } WORLDTilemapLayer;
 
-#define TILES_POINTER_TYPE(layer_pointer) WORLDTile (*)[layer_pointer->sizeY][layer_pointer->sizeX]
-
 typedef struct WORLDTilemap
 {
     WORLDTilemapLayer * layers;
     uint16_t amount;
     uint16_t mapWidth; // Used for camera collision
     uint16_t mapHeight; // Used for camera collision
+
+    // 1 bit per tile, set wherever any LAYER_COLLIDABLE layer has a tile (built on load, see IsSolidInRect)
+    // and wherever any layer has a TILE_SOLID tile once BuildCollisionGrid is given a tileset
+
+    uint64_t * collision; // [collisionHeight][collisionWords]
+    uint16_t collisionWidth;
+    uint16_t collisionHeight;
+    uint16_t collisionWords; // uint64_t per row
+
+    void * mapping; // Mapped .ywmap file the layer chunks point into (NULL if the chunks were allocated)
+    size_t mappingSize;
 } WORLDTilemap;
 
+// A ray (or segment) for CastTileRays, in tiles with tile (x, y) covering x to x + 1
+typedef struct WORLDRay
+{
+    float originX;
+    float originY;
+    float directionX; // Doesn't have to be normalised
+    float directionY;
+    float maxDistance; // Tiles along (direction) the ray goes before it gives up
+} WORLDRay;
+
+typedef struct WORLDRayHit
+{
+    float distance; // Tiles from the origin to where the ray entered the hit cell (0 if it started inside it)
+    int32_t cellX; // Solid cell that was hit, -1 if nothing was
+    int32_t cellY;
+    uint8_t hit;
+    uint8_t side; // 0 if the ray entered the cell through its left / right edge, 1 through its top / bottom one
+} WORLDRayHit;
+
+// Map object layers, the entities placed on a map (chests, teleporters, buildings...) kept next to it in their own JSON
+
+#define WORLD_OBJECT_PAYLOAD 4 // Type specific values an object can have
+#define WORLD_OBJECT_TYPE_LENGTH 32 // Longest type name + 1
+
+// One placement in an object layer, positions and sizes are in tiles
+typedef struct WORLDObject
+{
+    float x;
+    float y;
+    float width;
+    float height;
+    uint16_t depth; // Tilemap layer it's drawn with
+    float payload[WORLD_OBJECT_PAYLOAD]; // What the values mean depends on the type (0 if not given)
+} WORLDObject;
+
+// The objects of one type, next to each other in the order they're in the file
+typedef struct WORLDObjectGroup
+{
+    char type[WORLD_OBJECT_TYPE_LENGTH];
+    WORLDObject * objects;
+    uint32_t amount;
+} WORLDObjectGroup;
+
+typedef struct WORLDObjectLayer
+{
+    WORLDObject * objects; // Every object grouped by type, one allocation the groups point into
+    uint32_t amount;
+    WORLDObjectGroup * groups;
+    uint16_t amountOfGroups;
+} WORLDObjectLayer;
+
 // tilemap_layer FLAGS
 
 #define LAYER_COLLIDABLE 1
 #define LAYER_INVISIBLE 2
 #define LAYER_SPAWN 4
 
-// Returns the address of a parsed tilemap based on a Spritefusion map JSON, NULL on failure
+// Layer encodings, layers with less than LAYER_PALETTE_SIZE different tiles (counting the empty one) store uint8_t indices
+// into a palette instead of WORLDTiles, which halves their chunks
+
+#define LAYER_ENCODING_WIDE 0
+#define LAYER_ENCODING_PALETTE 1
+#define LAYER_PALETTE_SIZE 256
+
+// Bytes of the tiles of a layer with (amountOfChunks) chunks in (encoding), the palette included
+#define LAYER_CHUNK_BYTES(amountOfChunks, encoding) ((encoding) == LAYER_ENCODING_PALETTE ? \
+    LAYER_PALETTE_SIZE * sizeof(WORLDTile) + (size_t) (amountOfChunks) * WORLD_CHUNK_TILES : (size_t) (amountOfChunks) * WORLD_CHUNK_TILES * sizeof(WORLDTile))
+
+// Metadata of one tile of a spritesheet, worked out once per spritesheet so renderers and collision just look it up
+
+typedef struct WORLDTileInfo
+{
+    uint16_t sourceX; // Source rect in the spritesheet (pixels), it's tileSize x tileSize
+    uint16_t sourceY;
+    uint8_t FLAGS;
+    uint8_t page; // Which spritesheet of the tileset the source rect is in
+} WORLDTileInfo;
+
+// Most spritesheets (pages) a tileset can have
+#define MAX_TILESET_PAGES 16
+
+typedef struct WORLDTileset
+{
+    WORLDTileInfo * tiles; // Indexed by WORLDTile, so tiles[0] is the empty tile and tiles[n] is Spritefusion id n - 1
+    uint16_t amount; // Tiles in every page + 1
+    uint16_t tileSize;
+    uint8_t amountOfPages; // Page 0 is the spritesheet the tileset was created with, see AddTilesetPage
+} WORLDTileset;
+
+// WORLDTileInfo FLAGS
+
+#define TILE_SOLID 1
+#define TILE_WATER 2
+#define TILE_GRASS 4 // Encounter grass
+#define TILE_ANIMATED 8
+#define TILE_OPAQUE 16 // Hides everything under it
+
+// Which tile of which sprite sheet a WORLDTile of a Spritefusion project file is
+typedef struct WORLDSheetTile
+{
+    uint16_t sheet; // Index in WORLDSpriteSheets images
+    uint16_t tile; // Spritefusion id in that sheet (row by row, tileSize x tileSize tiles)
+} WORLDSheetTile;
+
+// The sprite sheets embedded in a Spritefusion project file (see CreateTilemapFromProject)
+typedef struct WORLDSpriteSheets
+{
+    void ** images; // [amount], what the WORLDSpriteSheetDecoder returned for every sheet
+    uint16_t amount;
+    WORLDSheetTile * tiles; // [amountOfTiles + 1], indexed by WORLDTile (tiles[0] is the empty tile)
+    uint16_t amountOfTiles;
+    uint16_t tileSize;
+} WORLDSpriteSheets;
+
+// Decodes the file (a PNG) of a sprite sheet embedded in a project file into an image, NULL on failure
+// Called from the map load threads, so it has to be thread safe
+typedef void * (*WORLDSpriteSheetDecoder)(const unsigned char * data, size_t size);
+
+// Frees an image returned by a WORLDSpriteSheetDecoder
+typedef void (*WORLDSpriteSheetFree)(void * image);
+
+// Compiled binary tilemap (.ywmap), made from a map JSON by Tools/Map_Compiler (make maps). All values are in the byte
+// order of the machine that compiled it, a file with the wrong magic / version / byte order is ignored and the JSON is used
+// Layout: YWMAPHeader, YWMAPLayer[amount], then each layer's chunk table, chunks and row spans (YWMAP_ALIGNMENT byte aligned)
+
+#define YWMAP_MAGIC 0x504d5759 // "YWMP" in a little-endian file
+#define YWMAP_VERSION 3
+#define YWMAP_ALIGNMENT 16
+#define YWMAP_EXTENSION ".ywmap"
+
+typedef struct YWMAPHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t amount;
+    uint16_t mapWidth;
+    uint16_t mapHeight;
+    uint32_t reserved;
+} YWMAPHeader;
+
+typedef struct YWMAPLayer
+{
+    uint16_t offsetX;
+    uint16_t offsetY;
+    uint16_t sizeX;
+    uint16_t sizeY;
+    uint16_t chunkX;
+    uint16_t chunkY;
+    uint16_t chunksX;
+    uint16_t chunksY;
+    uint32_t amountOfChunks;
+    uint32_t chunkTable; // Byte offset of the chunk table from the start of the file (0 for empty layers)
+    uint32_t tiles; // Byte offset of the chunks (palette layers: the palette, then the chunks) from the start of the file (0 for empty layers)
+    uint8_t FLAGS;
+    uint8_t encoding;
+    uint8_t reserved[2];
+    uint32_t rowSpans; // Byte offset of the row span index (uint32_t[sizeY + 1]) from the start of the file (0 for empty layers)
+    uint32_t spans; // Byte offset of the row spans (WORLDTileSpan[amountOfSpans]) from the start of the file
+    uint32_t amountOfSpans;
+    uint32_t reserved2;
+} YWMAPLayer;
+
+// Returns the address of a tilemap based on a Spritefusion map JSON (map export or project file), NULL on failure
+// Loads the compiled .ywmap next to it instead if there is one that isn't older than the JSON (or if jsonPath is a .ywmap)
 extern WORLDTilemap * CreateTilemap(const char * jsonPath);
 
+// Returns the address of a parsed tilemap based on a Spritefusion map JSON (map export or project file), NULL on failure
+extern WORLDTilemap * CreateTilemapFromJSON(const char * jsonPath);
+
+// Same as CreateTilemapFromJSON, but the sprite sheets embedded in a Spritefusion project file are decoded with (decoder)
+// on the same threads as the layers and put in (sheets) with which sheet tile every WORLDTile is (free it with FreeSpriteSheets)
+// On failure the decoded images are freed with (freeImage)
+extern WORLDTilemap * CreateTilemapFromProject(const char * jsonPath, WORLDSpriteSheetDecoder decoder, WORLDSpriteSheetFree freeImage,
+                                               WORLDSpriteSheets * sheets);
+
+// Frees what CreateTilemapFromProject put in (sheets), the images too with (freeImage) if it isn't NULL
+extern void FreeSpriteSheets(WORLDSpriteSheets * sheets, WORLDSpriteSheetFree freeImage);
+
+// Maps a compiled .ywmap file into memory and points the layer tiles into it, NULL on failure
+extern WORLDTilemap * LoadTilemapBinary(const char * path);
+
+// Writes a tilemap as a compiled .ywmap file, returns 1 on success
+extern _Bool SaveTilemapBinary(const WORLDTilemap * tilemap, const char * path);
+
+// Frees a tilemap returned by CreateTilemap (and all of its layers)
+extern void FreeTilemap(WORLDTilemap * tilemap);
+
 // Prints a tilemap_layer (for debugging)
 extern void PrintLayer(WORLDTilemapLayer * layer);
 
 // Access a position in a WORLDTilemapLayer and returns a WORLDTile
-extern WORLDTile AccessPositionInLayer(uint16_t x, uint16_t y, WORLDTilemapLayer * layer);
\ No newline at end of file
+extern WORLDTile AccessPositionInLayer(uint16_t x, uint16_t y, WORLDTilemapLayer * layer);
+
+// Returns the tiles of a chunk (WORLDTile[WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE]) by chunk position, NULL if it's empty
+// (or if the layer is a palette layer)
+extern WORLDTile * GetLayerChunk(const WORLDTilemapLayer * layer, uint16_t chunkX, uint16_t chunkY);
+
+// Returns the palette indices of a chunk (uint8_t[WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE]) by chunk position, NULL if it's empty
+// (or if the layer isn't a palette layer)
+extern uint8_t * GetLayerPaletteChunk(const WORLDTilemapLayer * layer, uint16_t chunkX, uint16_t chunkY);
+
+// Returns the spans of tiles in a row of a layer (Y is a tile position) and puts how many there are in (amount)
+extern const WORLDTileSpan * GetLayerRowSpans(const WORLDTilemapLayer * layer, uint16_t y, uint32_t * amount);
+
+// Same as GetLayerRowSpans but without the tiles hidden by opaque tiles of lower layers (once BakeTileOcclusion ran)
+extern const WORLDTileSpan * GetLayerVisibleRowSpans(const WORLDTilemapLayer * layer, uint16_t y, uint32_t * amount);
+
+// Rebuilds the visible row spans of every layer from the TILE_OPAQUE tiles of (tileset) (lower layers are drawn on top)
+// Returns 0 if it couldn't be allocated (the layers then draw all of their tiles)
+extern _Bool BakeTileOcclusion(WORLDTilemap * tilemap, const WORLDTileset * tileset);
+
+// Rebuilds the collision bit-grid from the LAYER_COLLIDABLE layers and the TILE_SOLID tiles of (tileset) (can be NULL)
+// Returns 0 if it couldn't be allocated
+extern _Bool BuildCollisionGrid(WORLDTilemap * tilemap, const WORLDTileset * tileset);
+
+// Returns 1 if the collision bit-grid is set anywhere in the rect (tile positions, inclusive, can be outside the map)
+extern _Bool IsSolidInRect(const WORLDTilemap * tilemap, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
+// Walks the collision bit-grid along a ray cell by cell (DDA) and puts the first solid cell in (hit), returns hit -> hit
+// Outside the grid there's nothing to hit, rays starting outside it are moved onto it first
+extern _Bool CastTileRay(const WORLDTilemap * tilemap, const WORLDRay * ray, WORLDRayHit * hit);
+
+// Casts (amount) rays, hits[i] is the result of rays[i], returns how many of them hit something
+// Rays with nearby origins should be next to each other so the grid rows they walk stay in cache
+extern uint32_t CastTileRays(const WORLDTilemap * tilemap, const WORLDRay * rays, WORLDRayHit * hits, uint32_t amount);
+
+// Returns 1 if no solid cell is between two positions (in tiles, the cells of both ends included)
+extern _Bool HasLineOfSight(const WORLDTilemap * tilemap, float fromX, float fromY, float toX, float toY);
+
+// Gets how many bytes the tiles of a tilemap take up (chunks, chunk tables and row spans)
+extern size_t GetTilemapTileBytes(const WORLDTilemap * tilemap);
+// Returns the metadata table of a spritesheet with tileSize x tileSize tiles (row by row), NULL on failure
+extern WORLDTileset * CreateTileset(uint16_t sheetWidth, uint16_t sheetHeight, uint16_t tileSize);
+
+// Adds another spritesheet to a tileset as its next page, its tiles get the WORLDTiles after the ones already there
+// Returns the WORLDTile of its first tile, 0 on failure
+extern WORLDTile AddTilesetPage(WORLDTileset * tileset, uint16_t sheetWidth, uint16_t sheetHeight);
+
+// Sets tile FLAGS from a tile metadata JSON ({"solid": [ids], "water": [...], "grass": [...], "animated": [...], "opaque": [...]})
+// Returns 1 on success
+extern _Bool LoadTilesetFlags(WORLDTileset * tileset, const char * path);
+
+// Frees a tileset returned by CreateTileset
+extern void FreeTileset(WORLDTileset * tileset);
+
+// Returns the FLAGS of every tile at a position OR-ed together (all layers)
+extern uint8_t GetTileFlagsAt(const WORLDTilemap * tilemap, const WORLDTileset * tileset, uint16_t x, uint16_t y);
+
+// Loads an object layer JSON ({"objects": [{"type": "chest", "x": 1, "y": 2, "width": 1, "height": 1, "depth": 3,
+// "payload": [1, 0]}, ...]}, only type, x and y are required), NULL on failure
+extern WORLDObjectLayer * LoadObjectLayer(const char * path);
+
+// Returns the objects of a type in an object layer (can be NULL), NULL if there aren't any
+extern const WORLDObjectGroup * GetObjectGroup(const WORLDObjectLayer * layer, const char * type);
+
+// Frees an object layer returned by LoadObjectLayer
+extern void FreeObjectLayer(WORLDObjectLayer * layer);
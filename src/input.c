@@ -29,10 +29,276 @@
 
 #define MAX_INPUT_POINTS 11
 
+// Recorded input file layout: InputRecordingHeader then per frame:
+// float frame_time, uint8_t key_count, uint16_t keys[key_count], uint8_t mouse_down, float mouse_x, float mouse_y,
+// uint8_t touch_count, float touch[touch_count][2]
+#define INPUT_RECORDING_MAGIC "FWIR"
+#define INPUT_RECORDING_VERSION 2
+
+typedef struct InputRecordingHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t seed; // GetRandomValue's seed, a replay has to run on the same one to play out the same
+} InputRecordingHeader;
+
+// A snapshot of all input for a single frame
+typedef struct InputFrame
+{
+    float frame_time;
+    uint8_t key_count;
+    uint16_t keys[MAX_INPUT_KEYS];
+    _Bool mouse_down;
+    Vector2 mouse;
+    uint8_t touch_count;
+    Vector2 touch[MAX_INPUT_POINTS];
+} InputFrame;
+
+enum InputCaptureModes
+{
+    LIVE, RECORDING, REPLAYING
+};
+
+static InputFrame current_frame = {0};
+static InputFrame previous_frame = {0};
+
+static enum InputCaptureModes capture_mode = LIVE;
+static FILE * capture_file = NULL;
+static _Bool replay_finished = 0;
+static uint32_t capture_seed = 0;
+
 static uint8_t refresh = 0;
 
 static enum Input_Types current_input_style = KEYBOARD;
 
+// Input frames
+
+// Fills an InputFrame with Raylib's current input
+static void CaptureInputFrame(InputFrame * frame)
+{
+    memset(frame, 0, sizeof(InputFrame));
+    frame -> frame_time = GetFrameTime();
+
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU && frame -> key_count < MAX_INPUT_KEYS; key++)
+    {
+        if (IsKeyDown(key)) frame -> keys[frame -> key_count++] = key;
+    }
+
+    frame -> mouse_down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    frame -> mouse = GetMousePosition();
+
+    int touch_count = GetTouchPointCount();
+    if (touch_count > MAX_INPUT_POINTS) touch_count = MAX_INPUT_POINTS;
+    frame -> touch_count = touch_count;
+    for (uint8_t i = 0; i < frame -> touch_count; i++) frame -> touch[i] = GetTouchPosition(i);
+}
+
+static void WriteInputFrame(const InputFrame * frame, FILE * file)
+{
+    uint8_t mouse_down = frame -> mouse_down;
+    fwrite(&frame -> frame_time, sizeof(float), 1, file);
+    fwrite(&frame -> key_count, sizeof(uint8_t), 1, file);
+    fwrite(frame -> keys, sizeof(uint16_t), frame -> key_count, file);
+    fwrite(&mouse_down, sizeof(uint8_t), 1, file);
+    fwrite(&frame -> mouse, sizeof(float), 2, file);
+    fwrite(&frame -> touch_count, sizeof(uint8_t), 1, file);
+    fwrite(frame -> touch, sizeof(float) * 2, frame -> touch_count, file);
+}
+
+// Returns 0 if there are no frames left (or the file is corrupted)
+static _Bool ReadInputFrame(InputFrame * frame, FILE * file)
+{
+    uint8_t mouse_down = 0;
+    memset(frame, 0, sizeof(InputFrame));
+
+    if (fread(&frame -> frame_time, sizeof(float), 1, file) != 1) return 0;
+    if (fread(&frame -> key_count, sizeof(uint8_t), 1, file) != 1 || frame -> key_count > MAX_INPUT_KEYS) return 0;
+    if (fread(frame -> keys, sizeof(uint16_t), frame -> key_count, file) != frame -> key_count) return 0;
+    if (fread(&mouse_down, sizeof(uint8_t), 1, file) != 1) return 0;
+    if (fread(&frame -> mouse, sizeof(float), 2, file) != 2) return 0;
+    if (fread(&frame -> touch_count, sizeof(uint8_t), 1, file) != 1 || frame -> touch_count > MAX_INPUT_POINTS) return 0;
+    if (fread(frame -> touch, sizeof(float) * 2, frame -> touch_count, file) != frame -> touch_count) return 0;
+
+    frame -> mouse_down = mouse_down;
+    return 1;
+}
+
+// Captures this frame's input (or reads it from the replay), has to be called once at the start of every frame
+void BeginInputFrame(void)
+{
+    previous_frame = current_frame;
+
+    switch (capture_mode) 
+    {
+        case REPLAYING:
+            if (replay_finished) break;
+            if (!ReadInputFrame(&current_frame, capture_file))
+            {
+                // Replay ran out, the last frame is kept but nothing is held down anymore
+                replay_finished = 1;
+                current_frame.key_count = 0;
+                current_frame.mouse_down = 0;
+                current_frame.touch_count = 0;
+                break;
+            }
+
+            // Peeks ahead so the replay counts as finished right after its last frame, before another frame gets started
+            int next = fgetc(capture_file);
+            if (next == EOF) replay_finished = 1;
+            else ungetc(next, capture_file);
+            break;
+        case RECORDING:
+            CaptureInputFrame(&current_frame);
+            WriteInputFrame(&current_frame, capture_file);
+            break;
+        case LIVE:
+        default:
+            CaptureInputFrame(&current_frame);
+            break;
+    }
+}
+
+// Gets the frame time of the current input frame (the recorded one during a replay)
+float GetInputFrameTime(void)
+{
+    return current_frame.frame_time;
+}
+
+static _Bool IsKeyInFrame(const InputFrame * frame, int key)
+{
+    for (uint8_t i = 0; i < frame -> key_count; i++)
+    {
+        if (frame -> keys[i] == key) return 1;
+    }
+    return 0;
+}
+
+// Returns 1 if a key is held down this frame
+_Bool IsInputKeyDown(int key)
+{
+    return IsKeyInFrame(&current_frame, key);
+}
+
+// Returns 1 if a key started being held down this frame
+_Bool IsInputKeyPressed(int key)
+{
+    return IsKeyInFrame(&current_frame, key) && !IsKeyInFrame(&previous_frame, key);
+}
+
+// Returns 1 if the left mouse button is held down this frame
+_Bool IsInputMouseDown(void)
+{
+    return current_frame.mouse_down;
+}
+
+// Returns 1 if the left mouse button started being held down this frame
+_Bool IsInputMousePressed(void)
+{
+    return current_frame.mouse_down && !previous_frame.mouse_down;
+}
+
+// Gets the mouse position of the current input frame
+Vector2 GetInputMousePosition(void)
+{
+    return current_frame.mouse;
+}
+
+// Returns 1 if any key started being held down this frame
+static _Bool IsAnyInputKeyPressed(void)
+{
+    for (uint8_t i = 0; i < current_frame.key_count; i++)
+    {
+        if (!IsKeyInFrame(&previous_frame, current_frame.keys[i])) return 1;
+    }
+    return 0;
+}
+
+// Gets a touch point of the current input frame (like Raylib, point 0 falls back to the mouse)
+static Vector2 GetInputTouchPosition(uint8_t id)
+{
+    if (id < current_frame.touch_count) return current_frame.touch[id];
+    if (id == 0) return current_frame.mouse;
+    return (Vector2) {0, 0};
+}
+
+// Input recording and replaying
+
+// Starts writing every input frame to a file along with the random seed the session runs on, returns 0 on failure
+_Bool StartInputRecording(const char * path, uint32_t seed)
+{
+    StopInputCapture();
+
+    capture_file = fopen(path, "wb");
+    if (!capture_file)
+    {
+        printf("Couldn't create input recording \"%s\"!\n", path);
+        return 0;
+    }
+
+    InputRecordingHeader header = {.version = INPUT_RECORDING_VERSION, .seed = seed};
+    memcpy(header.magic, INPUT_RECORDING_MAGIC, sizeof(header.magic));
+    fwrite(&header, sizeof(header), 1, capture_file);
+
+    capture_mode = RECORDING;
+    capture_seed = seed;
+    return 1;
+}
+
+// Starts reading input frames from a file made by StartInputRecording instead of Raylib, returns 0 on failure
+_Bool StartInputReplay(const char * path)
+{
+    StopInputCapture();
+
+    capture_file = fopen(path, "rb");
+    if (!capture_file)
+    {
+        printf("Couldn't open input recording \"%s\"!\n", path);
+        return 0;
+    }
+
+    InputRecordingHeader header = {0};
+    if (fread(&header, sizeof(header), 1, capture_file) != 1 ||
+        memcmp(header.magic, INPUT_RECORDING_MAGIC, sizeof(header.magic)) ||
+        header.version != INPUT_RECORDING_VERSION)
+    {
+        printf("Invalid input recording \"%s\"!\n", path);
+        StopInputCapture();
+        return 0;
+    }
+
+    capture_mode = REPLAYING;
+    replay_finished = 0;
+    capture_seed = header.seed;
+    return 1;
+}
+
+// Stops recording or replaying and closes the file
+void StopInputCapture(void)
+{
+    if (capture_file) fclose(capture_file);
+    capture_file = NULL;
+    capture_mode = LIVE;
+}
+
+// Returns 1 while a replay is running
+_Bool IsInputReplaying(void)
+{
+    return capture_mode == REPLAYING;
+}
+
+// Returns 1 once a replay has run out of recorded frames
+_Bool IsInputReplayFinished(void)
+{
+    return replay_finished;
+}
+
+// Gets the random seed of the recording being written or replayed (pass it to SetRandomSeed)
+uint32_t GetInputRecordingSeed(void)
+{
+    return capture_seed;
+}
+
 // Gets the most recent input method
 enum Input_Types GetInputType(void)
 {
@@ -42,8 +308,8 @@ enum Input_Types GetInputType(void)
 // GetInputType is refreshed and on next GetInputTap, a refresh occurs
 void RefreshInput(void)
 {
-    if (GetKeyPressed() != 0) current_input_style = KEYBOARD;
-    else if (GetTouchPointCount() != 0) current_input_style = TOUCH;
+    if (IsAnyInputKeyPressed()) current_input_style = KEYBOARD;
+    else if (current_frame.touch_count != 0) current_input_style = TOUCH;
     refresh ^= 1;
 }
 
@@ -51,9 +317,9 @@ void RefreshInput(void)
 Vector2 * GetInputDown(void) 
 {
     static Vector2 Input_Points[MAX_INPUT_POINTS] = {0};
-    int iPoints = GetTouchPointCount() + IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-    if (iPoints >= MAX_INPUT_POINTS) iPoints = MAX_INPUT_POINTS;
-    for (uint8_t i = 0; i < iPoints; i++) Input_Points[i] = GetTouchPosition(i);
+    int iPoints = current_frame.touch_count + current_frame.mouse_down;
+    if (iPoints >= MAX_INPUT_POINTS) iPoints = MAX_INPUT_POINTS - 1;
+    for (uint8_t i = 0; i < iPoints; i++) Input_Points[i] = GetInputTouchPosition(i);
     Input_Points[iPoints] = (Vector2) {NAN, NAN};
     return Input_Points;
 }
@@ -62,7 +328,7 @@ static Vector2 GetInputTap_Ex(uint8_t id)
 {
     static Vector2 last_check[MAX_INPUT_POINTS] = {0};
 
-    Vector2 current_check = GetTouchPosition(id);
+    Vector2 current_check = GetInputTouchPosition(id);
 
     if (current_check.x == 0 && current_check.y == 0) 
     {
@@ -89,8 +355,8 @@ Vector2 GetInputTap(void)
     if (last_refresh != refresh)
     {
         memset(tap_cache, 0, sizeof(tap_cache));
-        tap_cache[0] = IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ? GetMousePosition() : (Vector2) {0, 0};
-        for (uint8_t i = 1; i < GetTouchPointCount() && i < MAX_INPUT_POINTS; i++)
+        tap_cache[0] = IsInputMousePressed() ? GetInputMousePosition() : (Vector2) {0, 0};
+        for (uint8_t i = 1; i < current_frame.touch_count && i < MAX_INPUT_POINTS; i++)
         {
             tap_cache[i] = GetInputTap_Ex(i - 0);
         }
@@ -25,10 +25,14 @@
 
 #include "../Include/raylib.h"
 #include <math.h>
+#include <stdint.h>
 
 // The max number of input points recorded at once
 #define MAX_INPUT_POINTS 11
 
+// The max number of keys recorded as held down in one frame
+#define MAX_INPUT_KEYS 32
+
 // Types of supported input methods
 enum Input_Types
 {
@@ -46,4 +50,47 @@ extern void RefreshInput(void);
 extern Vector2 * GetInputDown(void);
 
 // Gets the position of a tap or mouse click on screen
-extern Vector2 GetInputTap(void);
\ No newline at end of file
+extern Vector2 GetInputTap(void);
+
+// Input frames (every input read goes through the current frame so it can be recorded and replayed)
+
+// Captures this frame's input (or reads it from the replay), has to be called once at the start of every frame
+extern void BeginInputFrame(void);
+
+// Gets the frame time of the current input frame (the recorded one during a replay)
+extern float GetInputFrameTime(void);
+
+// Returns 1 if a key is held down this frame
+extern _Bool IsInputKeyDown(int key);
+
+// Returns 1 if a key started being held down this frame
+extern _Bool IsInputKeyPressed(int key);
+
+// Returns 1 if the left mouse button is held down this frame
+extern _Bool IsInputMouseDown(void);
+
+// Returns 1 if the left mouse button started being held down this frame
+extern _Bool IsInputMousePressed(void);
+
+// Gets the mouse position of the current input frame
+extern Vector2 GetInputMousePosition(void);
+
+// Input recording and replaying
+
+// Starts writing every input frame to a file along with the random seed the session runs on, returns 0 on failure
+extern _Bool StartInputRecording(const char * path, uint32_t seed);
+
+// Starts reading input frames from a file made by StartInputRecording instead of Raylib, returns 0 on failure
+extern _Bool StartInputReplay(const char * path);
+
+// Stops recording or replaying and closes the file
+extern void StopInputCapture(void);
+
+// Returns 1 while a replay is running
+extern _Bool IsInputReplaying(void);
+
+// Returns 1 once a replay has run out of recorded frames
+extern _Bool IsInputReplayFinished(void);
+
+// Gets the random seed of the recording being written or replayed (pass it to SetRandomSeed)
+extern uint32_t GetInputRecordingSeed(void);
@@ -34,12 +34,72 @@
 #include "Game_State.h"
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 #include "rayclock.h"
 #include "Save.h"
 #include "Dialogue.h"
+#include "Profiler.h"
+#include "Debug_Overlay.h"
+#include "Hitch_Recorder.h"
+#include "Asset_Telemetry.h"
+#include "Alloc_Tracker.h"
+#define ASSET_SUBSYSTEM "Main"
+#include "Asset_Tracker.h"
+#include "Render_Stats.h"
+#include <string.h>
+
+// Per-frame CPU time during an input replay, written to "<replay>.frames.csv" and summarised per game state on exit
+
+#define NUMBER_OF_TIMED_STATES (NUMBER_OF_GAME_STATES + 1) // Last one is for unknown / invalid game states
+
+static FILE * ReplayFrameTimes = NULL;
+static uint64_t ReplayFrames[NUMBER_OF_TIMED_STATES] = {0};
+static double ReplayTotalTime[NUMBER_OF_TIMED_STATES] = {0};
+static double ReplayMaxTime[NUMBER_OF_TIMED_STATES] = {0};
+
+static void OpenReplayFrameTimes(const char * replay_path)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s.frames.csv", replay_path);
+    ReplayFrameTimes = fopen(path, "w");
+    if (!ReplayFrameTimes) 
+    {
+        printf("Couldn't create \"%s\"!\n", path);
+        return;
+    }
+    fprintf(ReplayFrameTimes, "frame,state,cpu_ms\n");
+}
+
+static void RecordReplayFrameTime(uint64_t frame, enum GameStateTypes state, double seconds)
+{
+    uint8_t i = state <= Dialogue ? state : NUMBER_OF_TIMED_STATES - 1;
+
+    ReplayFrames[i]++;
+    ReplayTotalTime[i] += seconds;
+    if (seconds > ReplayMaxTime[i]) ReplayMaxTime[i] = seconds;
+
+    if (ReplayFrameTimes) fprintf(ReplayFrameTimes, "%llu,%s,%.4f\n", (unsigned long long) frame, GetGameStateName(i), seconds * 1000);
+}
+
+static void CloseReplayFrameTimes(void)
+{
+    printf("\nReplay CPU time per game state:\n");
+    for (uint8_t i = 0; i < NUMBER_OF_TIMED_STATES; i++)
+    {
+        if (!ReplayFrames[i]) continue;
+        printf("  %-14s %8llu frames, avg %.3f ms, max %.3f ms\n", 
+                GetGameStateName(i), (unsigned long long) ReplayFrames[i], 
+                ReplayTotalTime[i] * 1000 / ReplayFrames[i], ReplayMaxTime[i] * 1000);
+    }
+    if (ReplayFrameTimes) fclose(ReplayFrameTimes);
+    ReplayFrameTimes = NULL;
+}
+
 // Well this is the main function and yup that's about what it is
-int main(void)
+// Arguments: --record <file> records all input to a file, --replay <file> plays it back instead of live input,
+// --hitch-budget <ms> sets how long a frame can take before it's logged to HITCH_LOG_PATH (DEFAULT: 2x the 240 FPS frame time)
+int main(int argc, char ** argv)
 {
     // Init Window
 
@@ -49,11 +109,28 @@ int main(void)
 
     InitAudioDevice();
 
+    ALLOC_TRACKER_INIT();
+
+    // Input recording / replaying
+    // InitWindow seeds GetRandomValue with the time, so recordings carry their own seed for the replay to run on
+
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (!strcmp(argv[i], "--record") && StartInputRecording(argv[i + 1], (uint32_t) time(NULL))) SetRandomSeed(GetInputRecordingSeed());
+        else if (!strcmp(argv[i], "--replay") && StartInputReplay(argv[i + 1]))
+        {
+            SetRandomSeed(GetInputRecordingSeed());
+            OpenReplayFrameTimes(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--hitch-budget")) SetHitchBudget(atof(argv[i + 1]) / 1000);
+    }
+
     // Loading important stuff
 
     clock_t start = clock();
 
     LoadSave(NULL);
+    SubscribeZoneChange(UpdateBattleZone);
 
     SwapGameState(10000);    
     SetTargetFPS(240);
@@ -70,8 +147,19 @@ int main(void)
     Texture2D Cursor = LoadTexture("Assets/Cursor.png");
     SetTextureFilter(Cursor, TEXTURE_FILTER_BILINEAR);
     HideCursor();
+    uint64_t frame = 0;
     while (!WindowShouldClose())
     {
+        // Before any per-frame instrumentation starts so the frame doesn't get left open (the replay's last frame was the one before)
+        if (IsInputReplayFinished()) break;
+
+        double frame_start = GetTime();
+        BeginHitchFrame();
+        ALLOC_FRAME_BEGIN();
+        BeginInputFrame();
+
+        PROFILE_SCOPE("Frame");
+
         UpdateRayclock();
         BeginDrawing();
         ClearBackground((Color) {45,45,45,255});
@@ -91,43 +179,71 @@ int main(void)
                 break;
             case Disclamer:
                 RenderUIText("Note: This is a Fanmade recreation of FNaF World\n I do not own the assets, and music\nThis is a passion project\n The code will be 100% Free and Open Source\n(When the first demo comes out)", 0, 0, 0.06, CENTRE, (Font) {0}, WHITE);
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) SwapGameState(Title);
+                if (IsInputMousePressed()) SwapGameState(Title);
                 break;
             default:
                 
-                CreateParticleEx(temp, 0, 0, cosf(clock()/1000.) / 3, sinf(clock()/1000.) / 3, 0, NULL);
-                CreateParticleEx(temp, 0, 0, -cosf(clock()/1000.) / 3, -sinf(clock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, cosf(Rayclock()/1000.) / 3, sinf(Rayclock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, -cosf(Rayclock()/1000.) / 3, -sinf(Rayclock()/1000.) / 3, 0, NULL);
 
-                CreateParticleEx(temp, 0.5, 0.5, cosf(clock()/1000.) / 3, sinf(clock()/1000.) / 3, 0, NULL);
-                CreateParticleEx(temp, 0, 0, -cosf(clock()/1000.) / 3, -sinf(clock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0.5, 0.5, cosf(Rayclock()/1000.) / 3, sinf(Rayclock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, -cosf(Rayclock()/1000.) / 3, -sinf(Rayclock()/1000.) / 3, 0, NULL);
 
-                CreateParticleEx(temp, -0.5, 0.5, cosf(clock()/1000.) / 3, sinf(clock()/1000.) / 3, 0, NULL);
-                CreateParticleEx(temp, 0, 0, -cosf(clock()/1000.) / 3, -sinf(clock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, -0.5, 0.5, cosf(Rayclock()/1000.) / 3, sinf(Rayclock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, -cosf(Rayclock()/1000.) / 3, -sinf(Rayclock()/1000.) / 3, 0, NULL);
 
-                CreateParticleEx(temp, 0.5, -0.5, cosf(clock()/1000.) / 3, sinf(clock()/1000.) / 3, 0, NULL);
-                CreateParticleEx(temp, 0, 0, -cosf(clock()/1000.) / 3, -sinf(clock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0.5, -0.5, cosf(Rayclock()/1000.) / 3, sinf(Rayclock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, -cosf(Rayclock()/1000.) / 3, -sinf(Rayclock()/1000.) / 3, 0, NULL);
 
-                CreateParticleEx(temp, 0, 0, cosf(clock()/1000.) / 3, sinf(clock()/1000.) / 3, 0, NULL);
-                CreateParticleEx(temp, -0.5, -0.5, -cosf(clock()/1000.) / 3, -sinf(clock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, 0, 0, cosf(Rayclock()/1000.) / 3, sinf(Rayclock()/1000.) / 3, 0, NULL);
+                CreateParticleEx(temp, -0.5, -0.5, -cosf(Rayclock()/1000.) / 3, -sinf(Rayclock()/1000.) / 3, 0, NULL);
                 PutUIParticles();
                 
                 SetWindowTitle("FNaF World: C Edition - Unknown State");
                 RenderUIText("Unknown / Invalid Game State Entered.\nTap to go back to title screen!", 0, 0, 0.06, CENTRE, (Font) {0}, WHITE);
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) SwapGameState(Title);
+                if (IsInputMousePressed()) SwapGameState(Title);
                 break;
         }
-        DrawFPS(10,10);
+        PutDebugOverlay();
+
+        #ifdef PROFILER
+
+        if (IsKeyPressed(PROFILER_EXPORT_KEY)) PROFILE_EXPORT(PROFILER_TRACE_PATH);
+
+        #endif
+
+        if (IsKeyPressed(ASSET_LOAD_REPORT_KEY)) SaveAssetLoadReport(ASSET_LOAD_REPORT_PATH);
         
         // Refreshes Touch Input
         RefreshInput();
         PutTransitionAnimation();
 
-        if (GetInputType() == KEYBOARD) DrawTextureEx(Cursor, GetMousePosition(), 0, GetWindowScaleDPI().y  * 0.75f, WHITE);
+        if (GetInputType() == KEYBOARD) DrawTextureEx(Cursor, GetInputMousePosition(), 0, GetWindowScaleDPI().y  * 0.75f, WHITE);
+
+        if (IsInputReplaying()) RecordReplayFrameTime(frame, GetGameState(), GetTime() - frame_start);
+        frame++;
+
+        ALLOC_FRAME_END();
+        EndHitchFrame();
+        EndRenderStatsFrame();
         EndDrawing();
     }
     
     // Uniniting stuff
 
+    PROFILE_EXPORT(PROFILER_TRACE_PATH);
+    PrintAssetReport();
+    PrintAssetLoadReport();
+    SaveAssetLoadReport(ASSET_LOAD_REPORT_PATH);
+    ALLOC_REPORT();
+
+    if (IsInputReplaying()) 
+    {
+        CloseReplayFrameTimes();
+        PrintRenderStats();
+    }
+    StopInputCapture();
+
     CloseAudioDevice();
     CloseWindow();
     return 0;
@@ -1,8 +1,10 @@
 #include "../Include/raylib.h"
 #include <time.h>
 #include "rayclock.h"
+#include "input.h"
 
-clock_t raytime_clock = 0;
+// Starts at 1 so timestamps taken from it are never 0, which marks free particles and buttons that aren't pressed
+clock_t raytime_clock = 1;
 
 clock_t Rayclock(void) 
 {
@@ -11,5 +13,5 @@ clock_t Rayclock(void)
 
 void UpdateRayclock(void)
 {
-    raytime_clock += GetFrameTime() * CLOCKS_PER_SEC;
+    raytime_clock += GetInputFrameTime() * CLOCKS_PER_SEC;
 }
\ No newline at end of file